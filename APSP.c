@@ -0,0 +1,136 @@
+// All-pairs shortest paths on a WGraph ... COMP9024 25T1
+
+#include "APSP.h"
+#include "Parallel.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// WGraph uses 0 for "no edge"; inside the matrix that becomes INF,
+// chosen so that INF + INF still fits in an int
+#define INF   (INT_MAX / 2)
+#define TILE  64           // tile is TILE x TILE ints (16KB)
+
+typedef struct {
+   Graph g;
+   int  *d;      // N x N matrix, N = #tiles * TILE
+   int   N;
+   int   nT;     // #tiles per row
+   int   k;      // current phase
+} APSPArgs;
+
+static inline int *tile(APSPArgs *a, int ti, int tj) {
+   return a->d + (size_t)ti * TILE * a->N + (size_t)tj * TILE;
+}
+
+// Floyd-Warshall restricted to one tile whose own cells are also the
+// intermediates: c[i][j] = min(c[i][j], a[i][k] + b[k][j]) with k outermost;
+// a or b may be c itself
+static void fwTile(int *c, const int *a, const int *b, int N) {
+   int i, j, k;
+   for (k = 0; k < TILE; k++) {
+      const int *bk = b + (size_t)k * N;
+      for (i = 0; i < TILE; i++) {
+         int aik = a[(size_t)i * N + k];
+         int *ci = c + (size_t)i * N;
+         for (j = 0; j < TILE; j++) {
+            int s = aik + bk[j];
+            ci[j] = (s < ci[j]) ? s : ci[j];
+         }
+      }
+   }
+}
+
+// min-plus product accumulate for a tile independent of a and b:
+// the inner loop is a branch-free min over contiguous ints, which the
+// compiler vectorizes
+static void minPlusTile(int *restrict c, const int *restrict a, const int *restrict b, int N) {
+   int i, j, k;
+   for (i = 0; i < TILE; i++) {
+      int *ci = c + (size_t)i * N;
+      for (k = 0; k < TILE; k++) {
+         int aik = a[(size_t)i * N + k];
+         const int *bk = b + (size_t)k * N;
+         for (j = 0; j < TILE; j++) {
+            int s = aik + bk[j];
+            ci[j] = (s < ci[j]) ? s : ci[j];
+         }
+      }
+   }
+}
+
+static void loadRows(int lo, int hi, int worker, void *arg) {
+   APSPArgs *a = arg;
+   int v, j, w, weight;
+   for (v = lo; v < hi; v++) {
+      int *row = a->d + (size_t)v * a->N;
+      for (j = 0; j < a->N; j++)
+         row[j] = INF;
+      if (v < numOfVertices(a->g)) {
+         NeighbourIter it;
+         for (neighbours(a->g, v, &it); nextNeighbour(&it, &w, &weight); )
+            if (weight < row[w])
+               row[w] = weight;
+         row[v] = 0;
+      }
+   }
+   (void)worker;
+}
+
+// phase 2: tiles in row k and column k, chunk index t < nT is row tile (k,t),
+// t >= nT is column tile (t-nT,k)
+static void crossTiles(int lo, int hi, int worker, void *arg) {
+   APSPArgs *a = arg;
+   int t, k = a->k;
+   for (t = lo; t < hi; t++) {
+      if (t < a->nT) {
+         if (t != k)
+            fwTile(tile(a, k, t), tile(a, k, k), tile(a, k, t), a->N);
+      } else if (t - a->nT != k) {
+         fwTile(tile(a, t - a->nT, k), tile(a, t - a->nT, k), tile(a, k, k), a->N);
+      }
+   }
+   (void)worker;
+}
+
+// phase 3: every other tile (i,j) from (i,k) and (k,j)
+static void otherTiles(int lo, int hi, int worker, void *arg) {
+   APSPArgs *a = arg;
+   int t, k = a->k;
+   for (t = lo; t < hi; t++) {
+      int i = t / a->nT, j = t % a->nT;
+      if (i != k && j != k)
+         minPlusTile(tile(a, i, j), tile(a, i, k), tile(a, k, j), a->N);
+   }
+   (void)worker;
+}
+
+int *allPairsShortestPaths(Graph g) {
+   assert(g != NULL);
+   int nV = numOfVertices(g);
+   APSPArgs a;
+   a.g = g;
+   a.nT = (nV + TILE - 1) / TILE;
+   a.N = a.nT * TILE;
+   a.d = aligned_alloc(64, ((size_t)a.N * a.N + 16) * sizeof(int));
+   assert(a.d != NULL);
+
+   parallelFor(a.N, loadRows, &a);
+   for (a.k = 0; a.k < a.nT; a.k++) {
+      fwTile(tile(&a, a.k, a.k), tile(&a, a.k, a.k), tile(&a, a.k, a.k), a.N);
+      parallelFor(2 * a.nT, crossTiles, &a);
+      parallelFor(a.nT * a.nT, otherTiles, &a);
+   }
+
+   // compact N x N (padded) into nV x nV, INF -> NO_PATH
+   int *dist = malloc(((size_t)nV * nV + 1) * sizeof(int));
+   assert(dist != NULL);
+   int v, w;
+   for (v = 0; v < nV; v++) {
+      const int *row = a.d + (size_t)v * a.N;
+      for (w = 0; w < nV; w++)
+         dist[(size_t)v * nV + w] = (row[w] >= INF) ? NO_PATH : row[w];
+   }
+   free(a.d);
+   return dist;
+}
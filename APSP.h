@@ -0,0 +1,11 @@
+// All-pairs shortest paths on a WGraph ... COMP9024 25T1
+// blocked Floyd-Warshall over a contiguous copy of the adjacency matrix;
+// tiles of a phase run in parallel (Parallel.h)
+#include "WGraph.h"
+#include <limits.h>
+
+#define NO_PATH INT_MAX   // entry for pairs with no path
+
+// returns a newly allocated nV*nV array d, free()d by the caller, with
+// d[v*nV + w] = cost of a cheapest path from v to w (0 for v == w) or NO_PATH
+int *allPairsShortestPaths(Graph g);
@@ -0,0 +1,212 @@
+// Breadth-first search on the Graph ADT ... COMP9024 25T1
+
+#include "BFS.h"
+#include "Parallel.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// switch to bottom-up once the frontier's edges exceed 1/ALPHA of the unexplored edges,
+// and back to top-down once the frontier holds fewer than 1/BETA of the vertices
+#define ALPHA 14
+#define BETA  24
+
+#define WORD_BITS 64
+#define BIT(w)    ((uint64_t)1 << ((w) % WORD_BITS))
+
+typedef struct {
+   Graph     g;
+   Vertex   *parent;
+   int      *dist;
+   int      *deg;       // degree of each vertex
+   int       level;     // distance of the current frontier
+   Vertex   *queue;     // top-down frontier
+   int       qLen;
+   Vertex  **buf;       // per-worker output of a top-down step
+   int      *bufLen;
+   int      *bufCap;
+   uint64_t *front;     // bottom-up frontier bitset
+   uint64_t *next;
+   int       nWords;
+   long long*edges;     // per-worker sum of degrees added to the next frontier
+   int      *count;     // per-worker #vertices added to the next frontier
+} BFSState;
+
+static void initVertices(int lo, int hi, int worker, void *arg) {
+   BFSState *s = arg;
+   int v;
+   for (v = lo; v < hi; v++) {
+      s->parent[v] = NOT_REACHED;
+      if (s->dist != NULL)
+         s->dist[v] = NOT_REACHED;
+      s->deg[v] = degree(s->g, v);
+   }
+   (void)worker;
+}
+
+static void pushBuf(BFSState *s, int worker, Vertex w) {
+   if (s->bufLen[worker] == s->bufCap[worker]) {
+      s->bufCap[worker] = (s->bufCap[worker] == 0) ? 256 : 2 * s->bufCap[worker];
+      s->buf[worker] = realloc(s->buf[worker], s->bufCap[worker] * sizeof(Vertex));
+      assert(s->buf[worker] != NULL);
+   }
+   s->buf[worker][s->bufLen[worker]++] = w;
+}
+
+// expand every frontier vertex; a neighbour is claimed by whoever sets its parent first
+static void topDownStep(int lo, int hi, int worker, void *arg) {
+   BFSState *s = arg;
+   long long edges = 0;
+   int i;
+   for (i = lo; i < hi; i++) {
+      Vertex u = s->queue[i], w;
+      NeighbourIter it;
+      for (neighbours(s->g, u, &it); nextNeighbour(&it, &w); ) {
+         Vertex unseen = NOT_REACHED;
+         if (__atomic_load_n(&s->parent[w], __ATOMIC_RELAXED) == NOT_REACHED &&
+             __atomic_compare_exchange_n(&s->parent[w], &unseen, u, false,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            if (s->dist != NULL)
+               s->dist[w] = s->level + 1;
+            pushBuf(s, worker, w);
+            edges += s->deg[w];
+         }
+      }
+   }
+   s->edges[worker] = edges;
+   s->count[worker] = s->bufLen[worker];
+}
+
+// every unvisited vertex looks for a neighbour in the frontier
+// chunks are whole words of the bitsets, so each word of next[] has a single writer
+static void bottomUpStep(int lo, int hi, int worker, void *arg) {
+   BFSState *s = arg;
+   int nV = numOfVertices(s->g), i, count = 0;
+   long long edges = 0;
+   for (i = lo; i < hi; i++) {
+      uint64_t word = 0;
+      Vertex v, last = (i + 1) * WORD_BITS < nV ? (i + 1) * WORD_BITS : nV;
+      for (v = i * WORD_BITS; v < last; v++) {
+         if (s->parent[v] != NOT_REACHED)
+            continue;
+         Vertex w;
+         NeighbourIter it;
+         for (neighbours(s->g, v, &it); nextNeighbour(&it, &w); ) {
+            if (s->front[w / WORD_BITS] & BIT(w)) {
+               s->parent[v] = w;
+               if (s->dist != NULL)
+                  s->dist[v] = s->level + 1;
+               word |= BIT(v);
+               count++;
+               edges += s->deg[v];
+               break;
+            }
+         }
+      }
+      s->next[i] = word;
+   }
+   s->edges[worker] = edges;
+   s->count[worker] = count;
+}
+
+void bfs(Graph g, Vertex src, Vertex parent[], int dist[]) {
+   int nV = numOfVertices(g);
+   assert(src >= 0 && src < nV && parent != NULL);
+
+   int T = numWorkers(), t;   // read once: the per-worker arrays and every step use this T
+   BFSState s;
+   s.g = g;
+   s.parent = parent;
+   s.dist = dist;
+   s.level = 0;
+   s.nWords = (nV + WORD_BITS - 1) / WORD_BITS;
+   s.deg    = malloc(nV * sizeof(int));
+   s.queue  = malloc(nV * sizeof(Vertex));
+   s.front  = calloc(s.nWords, sizeof(uint64_t));
+   s.next   = calloc(s.nWords, sizeof(uint64_t));
+   s.buf    = calloc(T, sizeof(Vertex *));
+   s.bufLen = calloc(T, sizeof(int));
+   s.bufCap = calloc(T, sizeof(int));
+   s.edges  = calloc(T, sizeof(long long));
+   s.count  = calloc(T, sizeof(int));
+   assert(s.deg != NULL && s.queue != NULL && s.front != NULL && s.next != NULL &&
+          s.buf != NULL && s.bufLen != NULL && s.bufCap != NULL &&
+          s.edges != NULL && s.count != NULL);
+
+   parallelFor(nV, initVertices, &s);
+   long long unexplored = 0;   // sum of degrees of unvisited vertices
+   int v;
+   for (v = 0; v < nV; v++)
+      unexplored += s.deg[v];
+
+   parent[src] = src;
+   if (dist != NULL)
+      dist[src] = 0;
+   s.queue[0] = src;
+   s.qLen = 1;
+   unexplored -= s.deg[src];
+   long long frontEdges = s.deg[src];
+   int frontSize = 1;
+   bool bottomUp = false;
+
+   while (frontSize > 0) {
+      if (!bottomUp && frontEdges > unexplored / ALPHA) {
+         // queue -> bitset
+         memset(s.front, 0, s.nWords * sizeof(uint64_t));
+         int i;
+         for (i = 0; i < s.qLen; i++)
+            s.front[s.queue[i] / WORD_BITS] |= BIT(s.queue[i]);
+         bottomUp = true;
+      } else if (bottomUp && frontSize < nV / BETA) {
+         // bitset -> queue
+         int i;
+         s.qLen = 0;
+         for (i = 0; i < s.nWords; i++) {
+            uint64_t word = s.front[i];
+            while (word != 0) {
+               s.queue[s.qLen++] = i * WORD_BITS + __builtin_ctzll(word);
+               word &= word - 1;
+            }
+         }
+         bottomUp = false;
+      }
+
+      for (t = 0; t < T; t++)
+         s.bufLen[t] = s.edges[t] = s.count[t] = 0;
+      if (bottomUp) {
+         parallelForWorkers(s.nWords, T, bottomUpStep, &s);
+         uint64_t *tmp = s.front;
+         s.front = s.next;
+         s.next = tmp;
+      } else {
+         parallelForWorkers(s.qLen, T, topDownStep, &s);
+         s.qLen = 0;
+         for (t = 0; t < T; t++) {
+            if (s.bufLen[t] > 0)
+               memcpy(s.queue + s.qLen, s.buf[t], s.bufLen[t] * sizeof(Vertex));
+            s.qLen += s.bufLen[t];
+         }
+      }
+
+      frontSize = 0;
+      frontEdges = 0;
+      for (t = 0; t < T; t++) {
+         frontSize += s.count[t];
+         frontEdges += s.edges[t];
+      }
+      unexplored -= frontEdges;
+      s.level++;
+   }
+
+   for (t = 0; t < T; t++)
+      free(s.buf[t]);
+   free(s.buf);
+   free(s.bufLen);
+   free(s.bufCap);
+   free(s.edges);
+   free(s.count);
+   free(s.deg);
+   free(s.queue);
+   free(s.front);
+   free(s.next);
+}
@@ -0,0 +1,12 @@
+// Breadth-first search on the Graph ADT ... COMP9024 25T1
+// direction-optimizing: switches between top-down steps (expand a frontier queue)
+// and bottom-up steps (unvisited vertices look for a parent in a frontier bitset);
+// each step runs on all workers of Parallel.h
+#include "Graph.h"
+
+#define NOT_REACHED -1
+
+// parent[v] = vertex before v on a shortest path from src (parent[src] = src)
+// dist[v]   = #edges on that path
+// both are NOT_REACHED for vertices that cannot be reached; dist may be NULL
+void bfs(Graph g, Vertex src, Vertex parent[], int dist[]);
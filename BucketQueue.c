@@ -0,0 +1,152 @@
+// Monotone Bucket Queue ADT implementation ... COMP9024 25T1
+// maxStep+1 buckets used as a ring: bucket k % nBuckets holds the items with
+// key k, for keys from cur (the smallest possible key) to cur + maxStep;
+// each bucket is a doubly linked list threaded through next[]/prev[];
+// buckets pushed to since the last clear are listed in used[], so a clear
+// only visits those rather than all maxStep+1
+
+#include "BucketQueue.h"
+#include <assert.h>
+#include <stdlib.h>
+
+#define NONE -1
+
+typedef struct BucketQueueRep {
+   int *head;      // head[b] = first item in bucket b, or NONE
+   int *next;      // next/prev item in the same bucket, or NONE
+   int *prev;
+   int *key;       // key[item], valid while item is queued
+   bool *queued;
+   int  *used;     // used[0..nUsed-1] = buckets pushed to since the last clear
+   bool *inUsed;   // inUsed[b] iff b is listed in used[]
+   int  nUsed;
+   int  nBuckets;  // maxStep + 1
+   int  cur;       // no queued key is smaller; keys pushed must be in [cur, cur + maxStep]
+   bool started;   // cur has been set by a push since the last clear
+   int  size;
+   int  n;         // items are 0..n-1
+} BucketQueueRep;
+
+BucketQueue newBucketQueue(int n, int maxStep) {
+   assert(n >= 0 && maxStep >= 0);
+   BucketQueue q = malloc(sizeof(BucketQueueRep));
+   assert(q != NULL);
+   q->nBuckets = maxStep + 1;
+   q->head = malloc(q->nBuckets * sizeof(int));
+   q->next = malloc((n + 1) * sizeof(int));
+   q->prev = malloc((n + 1) * sizeof(int));
+   q->key = malloc((n + 1) * sizeof(int));
+   q->queued = calloc(n + 1, sizeof(bool));
+   q->used = malloc(q->nBuckets * sizeof(int));
+   q->inUsed = calloc(q->nBuckets, sizeof(bool));
+   assert(q->head != NULL && q->next != NULL && q->prev != NULL && q->key != NULL && q->queued != NULL);
+   assert(q->used != NULL && q->inUsed != NULL);
+   q->nUsed = 0;
+   q->n = n;
+   int b;
+   for (b = 0; b < q->nBuckets; b++)
+      q->head[b] = NONE;
+   q->size = 0;
+   q->cur = 0;
+   q->started = false;
+   return q;
+}
+
+void dropBucketQueue(BucketQueue q) {
+   assert(q != NULL);
+   free(q->head);
+   free(q->next);
+   free(q->prev);
+   free(q->key);
+   free(q->queued);
+   free(q->used);
+   free(q->inUsed);
+   free(q);
+}
+
+void BucketQueueClear(BucketQueue q) {
+   int i, item;
+   for (i = 0; i < q->nUsed; i++) {
+      int b = q->used[i];
+      for (item = q->head[b]; item != NONE; item = q->next[item])
+         q->queued[item] = false;
+      q->head[b] = NONE;
+      q->inUsed[b] = false;
+   }
+   q->nUsed = 0;
+   q->size = 0;
+   q->started = false;
+}
+
+bool BucketQueueIsEmpty(BucketQueue q) {
+   return (q->size == 0);
+}
+
+int BucketQueueSize(BucketQueue q) {
+   return q->size;
+}
+
+bool BucketQueueContains(BucketQueue q, int item) {
+   assert(item >= 0 && item < q->n);
+   return q->queued[item];
+}
+
+int BucketQueueKey(BucketQueue q, int item) {
+   assert(BucketQueueContains(q, item));
+   return q->key[item];
+}
+
+static inline int bucketOf(BucketQueue q, int key) {
+   return key % q->nBuckets;
+}
+
+static void removeFromBucket(BucketQueue q, int item) {
+   if (q->prev[item] != NONE)
+      q->next[q->prev[item]] = q->next[item];
+   else
+      q->head[bucketOf(q, q->key[item])] = q->next[item];
+   if (q->next[item] != NONE)
+      q->prev[q->next[item]] = q->prev[item];
+}
+
+void BucketQueuePush(BucketQueue q, int item, int key) {
+   assert(item >= 0 && item < q->n && key >= 0);
+   if (!q->started) {
+      q->cur = key;
+      q->started = true;
+   }
+   assert(key >= q->cur && key - q->cur < q->nBuckets);   // monotone, within maxStep
+
+   if (q->queued[item]) {   // change key: move to the other bucket
+      if (q->key[item] == key)
+         return;
+      removeFromBucket(q, item);
+   } else {
+      q->queued[item] = true;
+      q->size++;
+   }
+   int b = bucketOf(q, key);
+   if (!q->inUsed[b]) {
+      q->inUsed[b] = true;
+      q->used[q->nUsed++] = b;
+   }
+   q->key[item] = key;
+   q->prev[item] = NONE;
+   q->next[item] = q->head[b];
+   if (q->head[b] != NONE)
+      q->prev[q->head[b]] = item;
+   q->head[b] = item;
+}
+
+int BucketQueuePop(BucketQueue q, int *key) {
+   assert(q->size > 0);
+   while (q->head[bucketOf(q, q->cur)] == NONE)   // skip empty keys
+      q->cur++;
+   int item = q->head[bucketOf(q, q->cur)];
+   removeFromBucket(q, item);
+   q->queued[item] = false;
+   q->size--;
+   if (key != NULL)
+      *key = q->cur;
+   return item;
+}
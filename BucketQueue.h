@@ -0,0 +1,19 @@
+// Monotone Bucket Queue ADT interface (Dial's algorithm) ... COMP9024 25T1
+// items are ints 0..n-1 with small int keys; keys are taken out in
+// nondecreasing order and every key pushed lies between the last key
+// taken out (or the first key pushed) and that plus maxStep;
+// push/update O(1), pop amortised O(1) plus the number of empty keys skipped,
+// no key comparisons
+#include <stdbool.h>
+
+typedef struct BucketQueueRep *BucketQueue;
+
+BucketQueue newBucketQueue(int n, int maxStep);    // empty queue for items 0..n-1
+void dropBucketQueue(BucketQueue);                 // remove unwanted queue
+void BucketQueueClear(BucketQueue);                // remove all items, O(#items + #buckets used since the last clear)
+bool BucketQueueIsEmpty(BucketQueue);              // check whether queue is empty
+int  BucketQueueSize(BucketQueue);                 // #items in queue
+bool BucketQueueContains(BucketQueue, int item);   // check whether item is in queue
+int  BucketQueueKey(BucketQueue, int item);        // key of an item in queue
+void BucketQueuePush(BucketQueue, int item, int key);  // insert item, or change its key if already queued
+int  BucketQueuePop(BucketQueue, int *key);        // remove an item with smallest key (stored in *key if not NULL)
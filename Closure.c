@@ -0,0 +1,115 @@
+// Transitive closure of a Graph or WGraph ... COMP9024 25T1
+// pivots are taken 64 at a time: the 64 pivot rows of a block are first closed
+// among themselves, then every other row ORs in the pivot rows whose bit it has,
+// rows in parallel; as a pivot row only gains vertices it really reaches,
+// ORing in its final state rather than Warshall's intermediate one is still exact
+
+#include "Closure.h"
+#include "Parallel.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#define WORD_BITS 64
+#define BIT(w)    ((uint64_t)1 << ((w) % WORD_BITS))
+
+typedef struct ClosureRep {
+   uint64_t *bits;     // row v: bit w set iff v reaches w
+   int       nWords;   // #words per row
+   int       nV;
+} ClosureRep;
+
+typedef struct {
+   Graph     g;
+   Closure   c;
+   int       lo, hi;   // pivots of the current block
+} ClosureArgs;
+
+static inline uint64_t *row(Closure c, Vertex v) {
+   return c->bits + (size_t)v * c->nWords;
+}
+
+static inline bool hasBit(const uint64_t r[], Vertex w) {
+   return (r[w / WORD_BITS] & BIT(w)) != 0;
+}
+
+// row v = v plus its neighbours
+static void initRows(int lo, int hi, int worker, void *arg) {
+   ClosureArgs *a = arg;
+   Vertex v, w;
+   for (v = lo; v < hi; v++) {
+      uint64_t *r = row(a->c, v);
+      r[v / WORD_BITS] |= BIT(v);
+#ifdef WGRAPH
+      int weight;
+      NeighbourIter it;
+      for (neighbours(a->g, v, &it); nextNeighbour(&it, &w, &weight); )
+         r[w / WORD_BITS] |= BIT(w);
+#else
+      rowOr(a->g, v, r);
+      (void)w;
+#endif
+   }
+   (void)worker;
+}
+
+// r |= row k for each pivot k in [lo,hi) whose bit is set in r
+static void applyPivots(Closure c, uint64_t *r, int lo, int hi) {
+   int k, i;
+   for (k = lo; k < hi; k++) {
+      if (!hasBit(r, k))
+         continue;
+      const uint64_t *rk = row(c, k);
+      for (i = 0; i < c->nWords; i++)
+         r[i] |= rk[i];
+   }
+}
+
+static void updateRows(int lo, int hi, int worker, void *arg) {
+   ClosureArgs *a = arg;
+   Vertex v;
+   for (v = lo; v < hi; v++)
+      if (v < a->lo || v >= a->hi)   // pivot rows are final for this block already
+         applyPivots(a->c, row(a->c, v), a->lo, a->hi);
+   (void)worker;
+}
+
+Closure transitiveClosure(Graph g) {
+   assert(g != NULL);
+   int nV = numOfVertices(g), k, j;
+
+   Closure c = malloc(sizeof(ClosureRep));
+   assert(c != NULL);
+   c->nV = nV;
+   c->nWords = (nV + WORD_BITS - 1) / WORD_BITS;
+   c->bits = calloc((size_t)nV * c->nWords + 1, sizeof(uint64_t));
+   assert(c->bits != NULL);
+
+   ClosureArgs a;
+   a.g = g;
+   a.c = c;
+   parallelFor(nV, initRows, &a);
+
+   for (k = 0; k < nV; k += WORD_BITS) {
+      a.lo = k;
+      a.hi = (k + WORD_BITS < nV) ? k + WORD_BITS : nV;
+      // Warshall restricted to the pivot rows
+      int p;
+      for (p = a.lo; p < a.hi; p++)
+         for (j = a.lo; j < a.hi; j++)
+            applyPivots(c, row(c, j), p, p + 1);
+      parallelFor(nV, updateRows, &a);
+   }
+   return c;
+}
+
+void freeClosure(Closure c) {
+   assert(c != NULL);
+   free(c->bits);
+   free(c);
+}
+
+bool reachable(Closure c, Vertex v, Vertex w) {
+   assert(c != NULL && v >= 0 && v < c->nV && w >= 0 && w < c->nV);
+   return hasBit(row(c, v), w);
+}
@@ -0,0 +1,16 @@
+// Transitive closure of a Graph or WGraph ... COMP9024 25T1
+// Warshall's algorithm on bit-packed rows; compile with -DWGRAPH for WGraph.h
+// (directed, weights ignored), otherwise Graph.h is used
+// the closure takes V*V/8 bytes, e.g. 50 MB for 20000 vertices
+#ifdef WGRAPH
+#include "WGraph.h"
+#else
+#include "Graph.h"
+#endif
+#include <stdbool.h>
+
+typedef struct ClosureRep *Closure;
+
+Closure transitiveClosure(Graph g);                // O(V^3/64) work, spread over Parallel.h workers
+void    freeClosure(Closure);
+bool    reachable(Closure c, Vertex v, Vertex w);  // O(1): is there a path from v to w (true for v == w)
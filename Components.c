@@ -0,0 +1,76 @@
+// Connected components of a Graph ... COMP9024 25T1
+
+#include "Components.h"
+#include "Parallel.h"
+#include "UnionFind.h"
+#include <assert.h>
+#include <stdlib.h>
+
+typedef struct {
+   Graph     g;
+   UnionFind uf;
+   int      *comp;
+   int      *size;
+   int      *id;    // component id of each root
+} CCArgs;
+
+static void linkEdges(int lo, int hi, int worker, void *arg) {
+   CCArgs *a = arg;
+   Vertex v, w;
+   for (v = lo; v < hi; v++) {
+      NeighbourIter it;
+      for (neighbours(a->g, v, &it); nextNeighbour(&it, &w); )
+         if (w > v)   // each edge once
+            ufUnion(a->uf, v, w);
+   }
+   (void)worker;
+}
+
+static void findRoots(int lo, int hi, int worker, void *arg) {
+   CCArgs *a = arg;
+   Vertex v;
+   for (v = lo; v < hi; v++)
+      a->comp[v] = ufFind(a->uf, v);
+   (void)worker;
+}
+
+// comp[v] holds v's root, id[root] the root's component id
+static void relabel(int lo, int hi, int worker, void *arg) {
+   CCArgs *a = arg;
+   Vertex v;
+   for (v = lo; v < hi; v++) {
+      a->comp[v] = a->id[a->comp[v]];
+      if (a->size != NULL)
+         __atomic_fetch_add(&a->size[a->comp[v]], 1, __ATOMIC_RELAXED);
+   }
+   (void)worker;
+}
+
+int connectedComponents(Graph g, int comp[], int size[]) {
+   assert(g != NULL && comp != NULL);
+   int nV = numOfVertices(g), v, k = 0;
+   CCArgs a;
+   a.g = g;
+   a.uf = newUnionFind(nV);
+   a.comp = comp;
+   a.size = size;
+   a.id = malloc((nV + 1) * sizeof(int));
+   assert(a.id != NULL);
+
+   parallelFor(nV, linkEdges, &a);
+   parallelFor(nV, findRoots, &a);
+   dropUnionFind(a.uf);
+
+   // the root of each set is its smallest vertex, so numbering roots
+   // in vertex order numbers the components by smallest vertex
+   for (v = 0; v < nV; v++)
+      if (comp[v] == v)
+         a.id[v] = k++;
+   if (size != NULL)
+      for (v = 0; v < k; v++)
+         size[v] = 0;
+   parallelFor(nV, relabel, &a);
+
+   free(a.id);
+   return k;
+}
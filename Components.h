@@ -0,0 +1,9 @@
+// Connected components of a Graph ... COMP9024 25T1
+// edges are merged in parallel (Parallel.h) with a lock-free union-find
+#include "Graph.h"
+
+// comp[v] = id of v's component; ids are 0..k-1, numbered by smallest vertex
+// size[c] = #vertices in component c (size may be NULL, otherwise it needs k ints,
+//           at most numOfVertices(g))
+// returns k, the number of components
+int connectedComponents(Graph g, int comp[], int size[]);
@@ -0,0 +1,162 @@
+// Single-source shortest paths on a WGraph ... COMP9024 25T1
+
+#include "Dijkstra.h"
+#include "IHeap.h"
+#include "BucketQueue.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// dist/pred entries are valid only where seen[v] == epoch, so a search
+// never has to reset arrays it does not touch
+typedef struct DijkstraWorkRep {
+   IHeap     heap;      // frontier: either the heap
+   BucketQueue buckets; // or, for small integer weights, the bucket queue (the other is NULL)
+   int      *dist;
+   Vertex   *pred;
+   unsigned *seen;    // epoch in which dist[v] was first set
+   unsigned *done;    // epoch in which dist[v] became final
+   unsigned  epoch;
+   int       nV;
+} DijkstraWorkRep;
+
+DijkstraWork newDijkstraWork(int nV) {
+   assert(nV >= 0);
+   DijkstraWork w = malloc(sizeof(DijkstraWorkRep));
+   assert(w != NULL);
+   w->heap = newIHeap(nV);
+   w->buckets = NULL;
+   w->dist = malloc((nV + 1) * sizeof(int));
+   w->pred = malloc((nV + 1) * sizeof(Vertex));
+   w->seen = calloc(nV + 1, sizeof(unsigned));
+   w->done = calloc(nV + 1, sizeof(unsigned));
+   assert(w->dist != NULL && w->pred != NULL && w->seen != NULL && w->done != NULL);
+   w->epoch = 0;
+   w->nV = nV;
+   return w;
+}
+
+// a search on this workspace uses a bucket queue instead of the heap;
+// every edge weight must be at most maxWeight
+DijkstraWork newDijkstraWorkBuckets(int nV, int maxWeight) {
+   DijkstraWork w = newDijkstraWork(nV);
+   dropIHeap(w->heap);
+   w->heap = NULL;
+   w->buckets = newBucketQueue(nV, maxWeight);
+   return w;
+}
+
+void dropDijkstraWork(DijkstraWork w) {
+   assert(w != NULL);
+   if (w->heap != NULL)
+      dropIHeap(w->heap);
+   else
+      dropBucketQueue(w->buckets);
+   free(w->dist);
+   free(w->pred);
+   free(w->seen);
+   free(w->done);
+   free(w);
+}
+
+static inline bool seen(DijkstraWork w, Vertex v) {
+   return w->seen[v] == w->epoch;
+}
+
+// the frontier operations, on whichever queue the workspace has
+
+static inline void frontierClear(DijkstraWork w) {
+   if (w->heap != NULL)
+      IHeapClear(w->heap);
+   else
+      BucketQueueClear(w->buckets);
+}
+
+static inline bool frontierIsEmpty(DijkstraWork w) {
+   return (w->heap != NULL) ? IHeapIsEmpty(w->heap) : BucketQueueIsEmpty(w->buckets);
+}
+
+static inline void frontierPush(DijkstraWork w, Vertex v, int d) {
+   if (w->heap != NULL)
+      IHeapPush(w->heap, v, d);
+   else
+      BucketQueuePush(w->buckets, v, d);
+}
+
+static inline Vertex frontierPop(DijkstraWork w, int *d) {
+   return (w->heap != NULL) ? IHeapPop(w->heap, d) : BucketQueuePop(w->buckets, d);
+}
+
+// run Dijkstra from src into the workspace, stopping once target (if >= 0) is settled
+static void search(Graph g, Vertex src, Vertex target, DijkstraWork w) {
+   int nV = numOfVertices(g);
+   assert(w != NULL && nV <= w->nV);
+   assert(src >= 0 && src < nV && target < nV);
+
+   if (++w->epoch == 0) {   // wrapped around: old stamps could look current
+      int v;
+      for (v = 0; v < w->nV; v++)
+         w->seen[v] = w->done[v] = 0;
+      w->epoch = 1;
+   }
+   frontierClear(w);
+
+   w->dist[src] = 0;
+   w->pred[src] = -1;
+   w->seen[src] = w->epoch;
+   frontierPush(w, src, 0);
+
+   while (!frontierIsEmpty(w)) {
+      int d;
+      Vertex u = frontierPop(w, &d), v;
+      w->done[u] = w->epoch;
+      if (u == target)
+         break;
+
+      int weight;
+      NeighbourIter it;
+      for (neighbours(g, u, &it); nextNeighbour(&it, &v, &weight); ) {
+         if (w->done[v] == w->epoch)
+            continue;
+         int nd = (d > NO_PATH - weight) ? NO_PATH : d + weight;
+         if (!seen(w, v) || nd < w->dist[v]) {
+            w->dist[v] = nd;
+            w->pred[v] = u;
+            w->seen[v] = w->epoch;
+            frontierPush(w, v, nd);
+         }
+      }
+   }
+}
+
+void dijkstra(Graph g, Vertex src, Vertex target, int dist[], Vertex pred[], DijkstraWork work) {
+   assert(g != NULL && dist != NULL);
+   search(g, src, target, work);
+
+   int v, nV = numOfVertices(g);
+   for (v = 0; v < nV; v++) {
+      dist[v] = seen(work, v) ? work->dist[v] : NO_PATH;
+      if (pred != NULL)
+         pred[v] = seen(work, v) ? work->pred[v] : -1;
+   }
+}
+
+int shortestPath(Graph g, Vertex src, Vertex dst, Vertex path[], int *cost, DijkstraWork work) {
+   assert(g != NULL && path != NULL && dst >= 0);
+   search(g, src, dst, work);
+   if (!seen(work, dst))
+      return 0;
+
+   // follow pred back from dst, then reverse
+   int n = 0, i;
+   Vertex v;
+   for (v = dst; v != -1; v = work->pred[v])
+      path[n++] = v;
+   for (i = 0; i < n / 2; i++) {
+      Vertex t = path[i];
+      path[i] = path[n - 1 - i];
+      path[n - 1 - i] = t;
+   }
+   if (cost != NULL)
+      *cost = work->dist[dst];
+   return n;
+}
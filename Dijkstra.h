@@ -0,0 +1,29 @@
+// Single-source shortest paths on a WGraph ... COMP9024 25T1
+// Dijkstra's algorithm with an indexed heap over the neighbour iterator:
+// O((V+E) log V) on sparse graphs, or O(V + E + D) (D = largest distance)
+// with a bucket queue when the weights are small integers
+#include "WGraph.h"
+#include <limits.h>
+
+#define NO_PATH INT_MAX   // distance of vertices that cannot be reached
+
+// scratch space for one search at a time, reusable across searches on
+// graphs with at most the given number of vertices
+typedef struct DijkstraWorkRep *DijkstraWork;
+
+DijkstraWork newDijkstraWork(int nV);
+DijkstraWork newDijkstraWorkBuckets(int nV, int maxWeight);   // for weights 1..maxWeight: Dial's
+                                                              // bucket queue (BucketQueue.h) instead of the heap
+void         dropDijkstraWork(DijkstraWork);
+
+// dist[v] = cost of a cheapest path from src to v, or NO_PATH
+// pred[v] = vertex before v on that path, -1 for src and unreached vertices (pred may be NULL)
+// if target >= 0 the search stops as soon as target's distance is final;
+// dist[] is then exact only for vertices settled before target (others are upper bounds)
+void dijkstra(Graph g, Vertex src, Vertex target, int dist[], Vertex pred[], DijkstraWork work);
+
+// write a cheapest path src, ..., dst into path[] (room for numOfVertices(g) vertices)
+// returns the number of vertices on the path, 0 if dst cannot be reached;
+// the cost is stored in *cost if cost is not NULL
+// only the part of the graph explored before dst is settled is touched
+int shortestPath(Graph g, Vertex src, Vertex dst, Vertex path[], int *cost, DijkstraWork work);
@@ -1,33 +1,221 @@
 // Graph ADT
-// Adjacency Matrix Representation ... COMP9024 25T1
+// Bit-packed Adjacency Matrix or Adjacency List Representation ... COMP9024 25T1
+// plus a packed array of all edges with a hash index into it
 #include "Graph.h"
+#include "Parallel.h"
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 typedef struct GraphRep {
-   int  **edges;   // adjacency matrix
-   int    nV;      // #vertices
-   int    nE;      // #edges
+   bool      sparse;  // adjacency lists instead of adjacency matrix
+   uint64_t *bits;    // adjacency matrix, one bit per cell, rows stored contiguously
+   int       nWords;  // #words per row, enough for vCap vertices
+   Vertex  **adj;     // adjacency lists (sparse graphs only)
+   int      *deg;     // #entries in each adjacency list
+   int      *cap;     // allocated size of each adjacency list
+   Vertex   *pool;    // single block holding copied adjacency lists, or NULL
+   size_t    poolLen; // #entries in pool
+   Edge     *edgeList;// all edges (v <= w), packed in positions 0..nE-1
+   int       edgeCap; // allocated size of edgeList
+   int      *arcPos;  // sparse graphs: for edge i, arcPos[2i] = position of w in v's
+                      // list and arcPos[2i+1] = position of v in w's list
+   uint64_t *slotKey; // index map (v,w) -> position in edgeList,
+   int      *slotPos; // open addressing with linear probing
+   int       nSlots;  // #slots, a power of 2
+   void     *map;     // file mapping the arrays point into (loadGraph), or NULL
+   size_t    mapLen;
+   int       nV;      // #vertices
+   int       nE;      // #edges
+   int       vCap;    // #vertices there is room for (rows of bits, entries of adj/deg/cap)
+   bool     *removed; // removed[v] iff v was removed and awaits reuse, or NULL if none ever was
+   Vertex   *freeIds; // stack of removed vertices
+   int       nFree, freeCap;
 } GraphRep;
 
+#define WORD_BITS 64
+#define BIT(w)    ((uint64_t)1 << ((w) % WORD_BITS))
+#define NO_KEY    UINT64_MAX
+
+// pointer to the first word of row v
+static inline uint64_t *row(Graph g, Vertex v) {
+   return g->bits + (size_t)v * g->nWords;
+}
+
+// hash map key of the undirected edge v-w
+static inline uint64_t edgeKey(Vertex v, Vertex w) {
+   if (v > w) {
+      Vertex t = v; v = w; w = t;
+   }
+   return ((uint64_t)v << 32) | (uint32_t)w;
+}
+
+static inline int slotOf(Graph g, uint64_t key) {
+   key ^= key >> 33;
+   key *= 0xff51afd7ed558ccdULL;
+   key ^= key >> 33;
+   return (int)(key & (uint64_t)(g->nSlots - 1));
+}
+
+// slot holding key, or the empty slot where it would go
+static int findSlot(Graph g, uint64_t key) {
+   int i = slotOf(g, key);
+   while (g->slotKey[i] != NO_KEY && g->slotKey[i] != key)
+      i = (i + 1) & (g->nSlots - 1);
+   return i;
+}
+
+static void initIndex(Graph g, int nSlots) {
+   g->nSlots = nSlots;
+   g->slotKey = malloc(nSlots * sizeof(uint64_t));
+   g->slotPos = malloc(nSlots * sizeof(int));
+   assert(g->slotKey != NULL && g->slotPos != NULL);
+   int i;
+   for (i = 0; i < nSlots; i++)
+      g->slotKey[i] = NO_KEY;
+}
+
+// position in edgeList of edge v-w, which must be in the graph
+static inline int edgeIndex(Graph g, Vertex v, Vertex w) {
+   return g->slotPos[findSlot(g, edgeKey(v, w))];
+}
+
+// record edge v-w at the end of edgeList
+// for sparse graphs the arcs must already be at the end of both adjacency lists
+static void addToIndex(Graph g, Vertex v, Vertex w) {
+   if (g->nE == g->edgeCap) {
+      g->edgeCap = (g->edgeCap == 0) ? 16 : 2 * g->edgeCap;
+      g->edgeList = realloc(g->edgeList, g->edgeCap * sizeof(Edge));
+      assert(g->edgeList != NULL);
+      if (g->sparse) {
+         g->arcPos = realloc(g->arcPos, 2 * g->edgeCap * sizeof(int));
+         assert(g->arcPos != NULL);
+      }
+   }
+   if (2 * (g->nE + 1) > g->nSlots) {   // keep load factor <= 1/2
+      uint64_t *oldKey = g->slotKey;
+      int      *oldPos = g->slotPos;
+      int i, oldSlots = g->nSlots;
+      initIndex(g, 2 * oldSlots);
+      for (i = 0; i < oldSlots; i++) {
+         if (oldKey[i] != NO_KEY) {
+            int j = findSlot(g, oldKey[i]);
+            g->slotKey[j] = oldKey[i];
+            g->slotPos[j] = oldPos[i];
+         }
+      }
+      free(oldKey);
+      free(oldPos);
+   }
+   Edge e = { v < w ? v : w, v < w ? w : v };
+   int i = findSlot(g, edgeKey(v, w));
+   g->slotKey[i] = edgeKey(v, w);
+   g->slotPos[i] = g->nE;
+   g->edgeList[g->nE] = e;
+   if (g->sparse) {
+      g->arcPos[2 * g->nE]     = g->deg[e.v] - 1;
+      g->arcPos[2 * g->nE + 1] = g->deg[e.w] - 1;
+   }
+}
+
+// forget edge v-w: move the last edge into its place in edgeList
+// and delete its slot by shifting later entries of the probe run back
+static void removeFromIndex(Graph g, Vertex v, Vertex w) {
+   int i = findSlot(g, edgeKey(v, w));
+   int pos = g->slotPos[i];
+   int last = g->nE - 1;
+
+   if (pos != last) {
+      Edge moved = g->edgeList[last];
+      g->edgeList[pos] = moved;
+      g->slotPos[findSlot(g, edgeKey(moved.v, moved.w))] = pos;
+      if (g->sparse) {
+         g->arcPos[2 * pos]     = g->arcPos[2 * last];
+         g->arcPos[2 * pos + 1] = g->arcPos[2 * last + 1];
+      }
+   }
+
+   int j = i;
+   for (;;) {
+      j = (j + 1) & (g->nSlots - 1);
+      if (g->slotKey[j] == NO_KEY)
+         break;
+      int home = slotOf(g, g->slotKey[j]);
+      // move j back into the hole at i unless its home lies in (i, j]
+      if ((j > i && (home <= i || home > j)) || (j < i && (home <= i && home > j))) {
+         g->slotKey[i] = g->slotKey[j];
+         g->slotPos[i] = g->slotPos[j];
+         i = j;
+      }
+   }
+   g->slotKey[i] = NO_KEY;
+}
+
 Graph newGraph(int V) {
    assert(V >= 0);
-   int i;
 
    Graph g = malloc(sizeof(GraphRep));
    assert(g != NULL);
+   g->sparse = false;
    g->nV = V;
    g->nE = 0;
+   g->nWords = (V + WORD_BITS - 1) / WORD_BITS;
+   g->adj = NULL;
+   g->deg = g->cap = NULL;
+   g->pool = NULL;
+   g->poolLen = 0;
+   g->edgeList = NULL;
+   g->edgeCap = 0;
+   g->arcPos = NULL;
+   g->map = NULL;
+   g->mapLen = 0;
+   g->vCap = V;
+   g->removed = NULL;
+   g->freeIds = NULL;
+   g->nFree = g->freeCap = 0;
+   initIndex(g, 16);
 
-   // allocate memory for each row
-   g->edges = malloc(V * sizeof(int *));
-   assert(g->edges != NULL);
-   // allocate memory for each column and initialise with 0
-   for (i = 0; i < V; i++) {
-      g->edges[i] = calloc(V, sizeof(int));
-      assert(g->edges[i] != NULL);
-   }
+   // allocate the whole matrix at once and initialise with 0
+   g->bits = calloc((size_t)V * g->nWords, sizeof(uint64_t));
+   assert(g->bits != NULL);
+
+   return g;
+}
+
+Graph newSparseGraph(int V) {
+   assert(V >= 0);
+
+   Graph g = malloc(sizeof(GraphRep));
+   assert(g != NULL);
+   g->sparse = true;
+   g->nV = V;
+   g->nE = 0;
+   g->nWords = (V + WORD_BITS - 1) / WORD_BITS;
+   g->bits = NULL;
+   g->pool = NULL;
+   g->poolLen = 0;
+   g->edgeList = NULL;
+   g->edgeCap = 0;
+   g->arcPos = NULL;
+   g->map = NULL;
+   g->mapLen = 0;
+   g->vCap = V;
+   g->removed = NULL;
+   g->freeIds = NULL;
+   g->nFree = g->freeCap = 0;
+   initIndex(g, 16);
+
+   // empty adjacency lists, grown on demand
+   g->adj = calloc(V, sizeof(Vertex *));
+   g->deg = calloc(V, sizeof(int));
+   g->cap = calloc(V, sizeof(int));
+   assert(g->adj != NULL && g->deg != NULL && g->cap != NULL);
 
    return g;
 }
@@ -41,30 +229,94 @@ bool validV(Graph g, Vertex v) {
    return (g != NULL && v >= 0 && v < g->nV);
 }
 
+// check if v's adjacency list lives in the shared pool rather than its own block
+static inline bool inPool(Graph g, Vertex v) {
+   return g->pool != NULL && g->adj[v] >= g->pool && g->adj[v] < g->pool + g->poolLen;
+}
+
+// append w to v's adjacency list
+static void addArc(Graph g, Vertex v, Vertex w) {
+   if (g->deg[v] == g->cap[v]) {
+      g->cap[v] = (g->cap[v] == 0) ? 4 : 2 * g->cap[v];
+      if (inPool(g, v)) {   // move the list out of the pool into its own block
+         Vertex *list = malloc(g->cap[v] * sizeof(Vertex));
+         assert(list != NULL);
+         memcpy(list, g->adj[v], g->deg[v] * sizeof(Vertex));
+         g->adj[v] = list;
+      } else {
+         g->adj[v] = realloc(g->adj[v], g->cap[v] * sizeof(Vertex));
+         assert(g->adj[v] != NULL);
+      }
+   }
+   g->adj[v][g->deg[v]++] = w;
+}
+
+// remove the entry at position pos of u's adjacency list in O(1)
+// by moving the last entry into its place and updating that edge's arcPos
+static void removeArcAt(Graph g, Vertex u, int pos) {
+   int last = --g->deg[u];
+   if (pos == last)
+      return;
+   Vertex x = g->adj[u][last];
+   g->adj[u][pos] = x;
+   int k = edgeIndex(g, u, x);
+   if (g->edgeList[k].v == u)
+      g->arcPos[2 * k] = pos;
+   if (g->edgeList[k].w == u)
+      g->arcPos[2 * k + 1] = pos;
+}
+
 void insertEdge(Graph g, Edge e) {
    assert(g != NULL && validV(g,e.v) && validV(g,e.w));
+   assert(g->map == NULL);   // loaded graphs are read-only
+   assert(g->removed == NULL || (!g->removed[e.v] && !g->removed[e.w]));
 
-   if (!g->edges[e.v][e.w]) {  // edge e not in graph
-      g->edges[e.v][e.w] = 1;
-      g->edges[e.w][e.v] = 1;
+   if (!adjacent(g, e.v, e.w)) {  // edge e not in graph
+      if (g->sparse) {
+         addArc(g, e.v, e.w);
+         if (e.v != e.w)
+            addArc(g, e.w, e.v);
+      } else {
+         row(g, e.v)[e.w / WORD_BITS] |= BIT(e.w);
+         row(g, e.w)[e.v / WORD_BITS] |= BIT(e.v);
+      }
+      addToIndex(g, e.v, e.w);
       g->nE++;
    }
 }
 
 void removeEdge(Graph g, Edge e) {
    assert(g != NULL && validV(g,e.v) && validV(g,e.w));
+   assert(g->map == NULL);   // loaded graphs are read-only
 
-   if (g->edges[e.v][e.w]) {   // edge e in graph
-      g->edges[e.v][e.w] = 0;
-      g->edges[e.w][e.v] = 0;
+   if (adjacent(g, e.v, e.w)) {   // edge e in graph
+      if (g->sparse) {
+         int i = edgeIndex(g, e.v, e.w);
+         Edge f = g->edgeList[i];
+         int posW = g->arcPos[2 * i + 1];
+         removeArcAt(g, f.v, g->arcPos[2 * i]);
+         if (f.v != f.w)
+            removeArcAt(g, f.w, posW);
+      } else {
+         row(g, e.v)[e.w / WORD_BITS] &= ~BIT(e.w);
+         row(g, e.w)[e.v / WORD_BITS] &= ~BIT(e.v);
+      }
+      removeFromIndex(g, e.v, e.w);
       g->nE--;
    }
 }
 
+// O(1): bit lookup for the matrix, index map lookup for adjacency lists
 bool adjacent(Graph g, Vertex v, Vertex w) {
    assert(g != NULL && validV(g,v) && validV(g,w));
 
-   return (g->edges[v][w] != 0);
+   if (g->sparse)
+      return g->slotKey[findSlot(g, edgeKey(v, w))] != NO_KEY;
+   return (row(g, v)[w / WORD_BITS] & BIT(w)) != 0;
+}
+
+static int compareVertex(const void *a, const void *b) {
+   return *(const Vertex *)a - *(const Vertex *)b;
 }
 
 void showGraph(Graph g) {
@@ -73,18 +325,783 @@ void showGraph(Graph g) {
 
     printf("Number of vertices: %d\n", g->nV);
     printf("Number of edges: %d\n", g->nE);
+    if (g->sparse) {
+       // print each list in ascending order, as for the matrix
+       Vertex *sorted = malloc((g->nV > 0 ? g->nV : 1) * sizeof(Vertex));
+       assert(sorted != NULL);
+       for (i = 0; i < g->nV; i++) {
+          if (g->deg[i] == 0)
+             continue;
+          memcpy(sorted, g->adj[i], g->deg[i] * sizeof(Vertex));
+          qsort(sorted, g->deg[i], sizeof(Vertex), compareVertex);
+          for (j = 0; j < g->deg[i]; j++)
+             if (sorted[j] > i)
+                printf("Edge %d - %d\n", i, sorted[j]);
+       }
+       free(sorted);
+       return;
+    }
     for (i = 0; i < g->nV; i++)
        for (j = i+1; j < g->nV; j++)
-	  if (g->edges[i][j])
+	  if (adjacent(g, i, j))
 	      printf("Edge %d - %d\n", i, j);
 }
 
 void freeGraph(Graph g) {
    assert(g != NULL);
 
-   int i;
-   for (i = 0; i < g->nV; i++)
-      free(g->edges[i]);
-   free(g->edges);
+   if (g->map != NULL) {   // only the vertex -> list pointers and removed flags live outside the mapping
+      munmap(g->map, g->mapLen);
+      free(g->adj);
+      free(g->removed);
+      free(g);
+      return;
+   }
+
+   if (g->sparse) {
+      int i;
+      for (i = 0; i < g->nV; i++)
+         if (!inPool(g, i))
+            free(g->adj[i]);
+      free(g->pool);
+      free(g->adj);
+      free(g->deg);
+      free(g->cap);
+   }
+   free(g->bits);
+   free(g->edgeList);
+   free(g->arcPos);
+   free(g->slotKey);
+   free(g->slotPos);
+   free(g->removed);
+   free(g->freeIds);
    free(g);
-}
\ No newline at end of file
+}
+
+// uniformly random integer in [0, n)
+static int randomBelow(int n) {
+   uint64_t r = ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+   return (int)(r % (uint64_t)n);
+}
+
+// O(1): pick a slot of the packed edge array
+Edge randomEdge(Graph g) {
+   assert(g != NULL && g->nE > 0);
+   return g->edgeList[randomBelow(g->nE)];
+}
+
+bool incident(Edge e1, Edge e2) {
+   return e1.v == e2.v || e1.v == e2.w || e1.w == e2.v || e1.w == e2.w;
+}
+
+// remove every edge at u, O(deg(u)) plus a row scan for the matrix
+// (each removeEdge is O(1) for both representations)
+static void removeEdgesAt(Graph g, Vertex u) {
+   int n = degree(g, u), i = 0;
+   if (n == 0)
+      return;
+   Vertex *nbrs = malloc(n * sizeof(Vertex));   // collect first, removal changes the row
+   assert(nbrs != NULL);
+   NeighbourIter it;
+   Vertex w;
+   for (neighbours(g, u, &it); nextNeighbour(&it, &w); )
+      nbrs[i++] = w;
+   for (i = 0; i < n; i++) {
+      Edge e = { u, nbrs[i] };
+      removeEdge(g, e);
+   }
+   free(nbrs);
+}
+
+// modifies g in place and returns it
+Graph deleteEdges(Graph g, Edge e) {
+   assert(g != NULL && validV(g,e.v) && validV(g,e.w));
+   removeEdgesAt(g, e.v);
+   removeEdgesAt(g, e.w);
+   return g;
+}
+
+// copies every array in one block each; adjacency lists of a sparse
+// graph are packed back to back into a single pool
+Graph copyGraph(Graph g) {
+   assert(g != NULL);
+
+   Graph c = malloc(sizeof(GraphRep));
+   assert(c != NULL);
+   *c = *g;
+   c->map = NULL;      // a copy of a loaded graph is an ordinary, writable graph
+   c->mapLen = 0;
+   c->vCap = g->nV;
+   c->removed = NULL;
+   c->freeIds = NULL;
+   c->freeCap = c->nFree;
+   if (g->nFree > 0) {
+      c->removed = malloc(g->nV * sizeof(bool));
+      c->freeIds = malloc(g->nFree * sizeof(Vertex));
+      assert(c->removed != NULL && c->freeIds != NULL);
+      memcpy(c->removed, g->removed, g->nV * sizeof(bool));
+      memcpy(c->freeIds, g->freeIds, g->nFree * sizeof(Vertex));
+   }
+
+   if (g->sparse) {
+      int v;
+      c->bits = NULL;
+      c->poolLen = 2 * (size_t)g->nE;
+      c->pool = malloc((c->poolLen > 0 ? c->poolLen : 1) * sizeof(Vertex));
+      c->adj = malloc((g->nV > 0 ? g->nV : 1) * sizeof(Vertex *));
+      c->deg = malloc((g->nV > 0 ? g->nV : 1) * sizeof(int));
+      c->cap = malloc((g->nV > 0 ? g->nV : 1) * sizeof(int));
+      assert(c->pool != NULL && c->adj != NULL && c->deg != NULL && c->cap != NULL);
+      memcpy(c->deg, g->deg, g->nV * sizeof(int));
+      memcpy(c->cap, g->deg, g->nV * sizeof(int));   // pooled lists are full
+      Vertex *next = c->pool;
+      for (v = 0; v < g->nV; v++) {
+         if (g->deg[v] == 0) {
+            c->adj[v] = NULL;
+            continue;
+         }
+         c->adj[v] = next;
+         memcpy(next, g->adj[v], g->deg[v] * sizeof(Vertex));
+         next += g->deg[v];
+      }
+   } else {
+      size_t nBits = (size_t)g->nV * g->nWords;
+      c->bits = malloc((nBits > 0 ? nBits : 1) * sizeof(uint64_t));
+      assert(c->bits != NULL);
+      memcpy(c->bits, g->bits, nBits * sizeof(uint64_t));
+   }
+
+   c->edgeCap = (g->nE > 0) ? g->nE : 1;
+   c->edgeList = malloc(c->edgeCap * sizeof(Edge));
+   c->slotKey = malloc(g->nSlots * sizeof(uint64_t));
+   c->slotPos = malloc(g->nSlots * sizeof(int));
+   assert(c->edgeList != NULL && c->slotKey != NULL && c->slotPos != NULL);
+   if (g->nE > 0)
+      memcpy(c->edgeList, g->edgeList, g->nE * sizeof(Edge));
+   if (g->sparse) {
+      c->arcPos = malloc(2 * c->edgeCap * sizeof(int));
+      assert(c->arcPos != NULL);
+      if (g->nE > 0)
+         memcpy(c->arcPos, g->arcPos, 2 * g->nE * sizeof(int));
+   }
+   memcpy(c->slotKey, g->slotKey, g->nSlots * sizeof(uint64_t));
+   memcpy(c->slotPos, g->slotPos, g->nSlots * sizeof(int));
+
+   return c;
+}
+
+bool graphIsEmpty(Graph g) {
+   assert(g != NULL);
+   return g->nE == 0;
+}
+
+// start iterating over the neighbours of v
+void neighbours(Graph g, Vertex v, NeighbourIter *it) {
+   assert(g != NULL && validV(g,v) && it != NULL);
+   it->g = g;
+   it->v = v;
+   it->pos = -1;
+   it->word = 0;
+}
+
+// fetch the next neighbour of it->v into *w
+// returns false once all neighbours have been visited
+// O(deg(v)) in total for adjacency lists, O(V/64 + deg(v)) for the matrix
+bool nextNeighbour(NeighbourIter *it, Vertex *w) {
+   Graph g = it->g;
+
+   if (g->sparse) {
+      if (it->pos + 1 >= g->deg[it->v])
+         return false;
+      *w = g->adj[it->v][++it->pos];
+      return true;
+   }
+   while (it->word == 0) {   // skip to the next word with a neighbour in it
+      if (++it->pos >= g->nWords)
+         return false;
+      it->word = row(g, it->v)[it->pos];
+   }
+   *w = it->pos * WORD_BITS + __builtin_ctzll(it->word);
+   it->word &= it->word - 1;   // clear lowest set bit
+   return true;
+}
+
+// number of 64-bit words in an adjacency row
+int rowWords(Graph g) {
+   assert(g != NULL);
+   return g->nWords;
+}
+
+// read-only view of v's adjacency row: bit w is set iff v and w are adjacent
+// only available for the matrix representation
+const uint64_t *graphRow(Graph g, Vertex v) {
+   assert(g != NULL && validV(g,v) && !g->sparse);
+   return row(g, v);
+}
+
+// set[] |= row of v
+void rowOr(Graph g, Vertex v, uint64_t set[]) {
+   assert(g != NULL && validV(g,v) && set != NULL);
+   int i;
+   if (g->sparse) {
+      for (i = 0; i < g->deg[v]; i++)
+         set[g->adj[v][i] / WORD_BITS] |= BIT(g->adj[v][i]);
+      return;
+   }
+   const uint64_t *r = row(g, v);
+   for (i = 0; i < g->nWords; i++)
+      set[i] |= r[i];
+}
+
+// set[] &= row of v
+void rowAnd(Graph g, Vertex v, uint64_t set[]) {
+   assert(g != NULL && validV(g,v) && set != NULL);
+   int i;
+   if (g->sparse) {
+      uint64_t *mask = calloc(g->nWords + 1, sizeof(uint64_t));
+      assert(mask != NULL);
+      rowOr(g, v, mask);
+      for (i = 0; i < g->nWords; i++)
+         set[i] &= mask[i];
+      free(mask);
+      return;
+   }
+   const uint64_t *r = row(g, v);
+   for (i = 0; i < g->nWords; i++)
+      set[i] &= r[i];
+}
+
+// number of bits set in set[0..nWords-1]
+int rowCount(const uint64_t set[], int nWords) {
+   int i, count = 0;
+   for (i = 0; i < nWords; i++)
+      count += __builtin_popcountll(set[i]);
+   return count;
+}
+
+// number of neighbours of v
+int degree(Graph g, Vertex v) {
+   assert(g != NULL && validV(g,v));
+   if (g->sparse)
+      return g->deg[v];
+   return rowCount(row(g, v), g->nWords);
+}
+
+// number of vertices adjacent to both v and w
+int commonNeighbours(Graph g, Vertex v, Vertex w) {
+   assert(g != NULL && validV(g,v) && validV(g,w));
+   int i, count = 0;
+   if (g->sparse) {
+      uint64_t *mask = calloc(g->nWords + 1, sizeof(uint64_t));
+      assert(mask != NULL);
+      rowOr(g, v, mask);
+      for (i = 0; i < g->deg[w]; i++)
+         if (mask[g->adj[w][i] / WORD_BITS] & BIT(g->adj[w][i]))
+            count++;
+      free(mask);
+      return count;
+   }
+   const uint64_t *rv = row(g, v), *rw = row(g, w);
+   for (i = 0; i < g->nWords; i++)
+      count += __builtin_popcountll(rv[i] & rw[i]);
+   return count;
+}
+
+// growing and shrinking
+
+// make room for at least one more vertex: capacity doubles, so the cost of
+// moving everything is amortised over the vertices added since the last move
+static void growVertices(Graph g) {
+   int newCap = (g->vCap < 32) ? 64 : 2 * g->vCap, v;
+
+   if (g->sparse) {   // lists stay where they are, only the per-vertex arrays move
+      g->adj = realloc(g->adj, newCap * sizeof(Vertex *));
+      g->deg = realloc(g->deg, newCap * sizeof(int));
+      g->cap = realloc(g->cap, newCap * sizeof(int));
+      assert(g->adj != NULL && g->deg != NULL && g->cap != NULL);
+   } else {
+      int newWords = (newCap + WORD_BITS - 1) / WORD_BITS;
+      if (newWords <= g->nWords) {   // rows are long enough already: extend the block
+         newWords = g->nWords;
+         g->bits = realloc(g->bits, (size_t)newCap * newWords * sizeof(uint64_t));
+         assert(g->bits != NULL);
+      } else {                       // rows get longer: copy them row by row
+         uint64_t *bits = calloc((size_t)newCap * newWords, sizeof(uint64_t));
+         assert(bits != NULL);
+         for (v = 0; v < g->nV; v++)
+            memcpy(bits + (size_t)v * newWords, row(g, v), g->nWords * sizeof(uint64_t));
+         free(g->bits);
+         g->bits = bits;
+         g->nWords = newWords;
+      }
+   }
+   if (g->removed != NULL) {
+      g->removed = realloc(g->removed, newCap * sizeof(bool));
+      assert(g->removed != NULL);
+   }
+   g->vCap = newCap;
+}
+
+// add an isolated vertex and return it; a removed vertex is reused if there is one
+// amortised O(1) for adjacency lists, O(V/64) for the matrix
+Vertex addVertex(Graph g) {
+   assert(g != NULL && g->map == NULL);
+   Vertex v;
+
+   if (g->nFree > 0) {   // removed vertices have no edges left, so reuse as is
+      v = g->freeIds[--g->nFree];
+      g->removed[v] = false;
+      return v;
+   }
+   if (g->nV == g->vCap)
+      growVertices(g);
+   v = g->nV++;
+   if (g->sparse) {
+      g->adj[v] = NULL;
+      g->deg[v] = g->cap[v] = 0;
+   } else {
+      memset(row(g, v), 0, g->nWords * sizeof(uint64_t));
+   }
+   if (g->removed != NULL)
+      g->removed[v] = false;
+   return v;
+}
+
+// remove all edges at v and keep v for reuse by addVertex
+// v stays a valid (isolated) vertex, so numOfVertices(g) does not change,
+// but no edges may be inserted at it until it is handed out again
+void removeVertex(Graph g, Vertex v) {
+   assert(g != NULL && validV(g,v) && g->map == NULL);
+   if (g->removed == NULL) {
+      g->removed = calloc(g->vCap + 1, sizeof(bool));
+      assert(g->removed != NULL);
+   }
+   assert(!g->removed[v]);
+
+   removeEdgesAt(g, v);
+   if (g->nFree == g->freeCap) {
+      g->freeCap = (g->freeCap == 0) ? 16 : 2 * g->freeCap;
+      g->freeIds = realloc(g->freeIds, g->freeCap * sizeof(Vertex));
+      assert(g->freeIds != NULL);
+   }
+   g->freeIds[g->nFree++] = v;
+   g->removed[v] = true;
+}
+
+// bulk construction
+
+typedef struct {
+   Graph       g;
+   const Edge *edges;
+   int         n;
+   int        *key;     // sparse: source vertex of each arc
+   int        *start;   // sparse: partition of arcs by source vertex
+   int        *order;
+   Vertex     *nbr;     // sparse: neighbour of each arc in partition order
+   int        *upper;   // #neighbours w >= v of each vertex, then their offsets
+} BuildArgs;
+
+static void setBits(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   Graph g = b->g;
+   int i;
+   for (i = lo; i < hi; i++) {
+      Edge e = b->edges[i];
+      assert(validV(g,e.v) && validV(g,e.w));
+      __atomic_fetch_or(&row(g, e.v)[e.w / WORD_BITS], BIT(e.w), __ATOMIC_RELAXED);
+      __atomic_fetch_or(&row(g, e.w)[e.v / WORD_BITS], BIT(e.v), __ATOMIC_RELAXED);
+   }
+   (void)worker;
+}
+
+// arc 2i is v->w and arc 2i+1 is w->v of edges[i]
+static void arcSources(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   int i;
+   for (i = lo; i < hi; i++) {
+      Edge e = b->edges[i];
+      assert(validV(b->g,e.v) && validV(b->g,e.w));
+      b->key[2 * i] = e.v;
+      b->key[2 * i + 1] = e.w;
+   }
+   (void)worker;
+}
+
+// sort and deduplicate each vertex's slice of nbr[]
+static void gatherLists(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   Graph g = b->g;
+   int v, i;
+   for (v = lo; v < hi; v++) {
+      Vertex *list = b->nbr + b->start[v];
+      int n = b->start[v + 1] - b->start[v], d = 0;
+      for (i = 0; i < n; i++) {
+         int a = b->order[b->start[v] + i];
+         Edge e = b->edges[a / 2];
+         list[i] = (a % 2 == 0) ? e.w : e.v;
+      }
+      qsort(list, n, sizeof(Vertex), compareVertex);
+      for (i = 0; i < n; i++)
+         if (d == 0 || list[i] != list[d - 1])
+            list[d++] = list[i];
+      g->deg[v] = g->cap[v] = d;
+   }
+   (void)worker;
+}
+
+static void copyLists(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   Graph g = b->g;
+   int v;
+   for (v = lo; v < hi; v++) {
+      if (g->deg[v] > 0)
+         memcpy(g->adj[v], b->nbr + b->start[v], g->deg[v] * sizeof(Vertex));
+   }
+   (void)worker;
+}
+
+static void countUpper(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   int v;
+   for (v = lo; v < hi; v++) {
+      NeighbourIter it;
+      Vertex w;
+      int n = 0;
+      for (neighbours(b->g, v, &it); nextNeighbour(&it, &w); )
+         if (w >= v)
+            n++;
+      b->upper[v] = n;
+   }
+   (void)worker;
+}
+
+// position of v in w's adjacency list, which is sorted right after a bulk build
+static int arcPosition(Graph g, Vertex w, Vertex v) {
+   Vertex *p = bsearch(&v, g->adj[w], g->deg[w], sizeof(Vertex), compareVertex);
+   assert(p != NULL);
+   return (int)(p - g->adj[w]);
+}
+
+static void fillEdges(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   Graph g = b->g;
+   int v;
+   for (v = lo; v < hi; v++) {
+      NeighbourIter it;
+      Vertex w;
+      int i = b->upper[v];
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w); ) {
+         if (w < v)
+            continue;
+         g->edgeList[i].v = v;
+         g->edgeList[i].w = w;
+         if (g->sparse) {
+            g->arcPos[2 * i] = it.pos;
+            g->arcPos[2 * i + 1] = arcPosition(g, w, v);
+         }
+         i++;
+      }
+   }
+   (void)worker;
+}
+
+// derive nE, the edge array and the index map from the adjacency structure
+static void buildEdgeIndex(Graph g) {
+   BuildArgs b;
+   b.g = g;
+   b.upper = malloc((g->nV + 1) * sizeof(int));
+   assert(b.upper != NULL);
+
+   parallelFor(g->nV, countUpper, &b);
+   int v, i, total = 0;
+   for (v = 0; v < g->nV; v++) {
+      int n = b.upper[v];
+      b.upper[v] = total;
+      total += n;
+   }
+   g->nE = total;
+
+   g->edgeCap = (total > 0) ? total : 1;
+   g->edgeList = malloc(g->edgeCap * sizeof(Edge));
+   assert(g->edgeList != NULL);
+   if (g->sparse) {
+      g->arcPos = malloc(2 * g->edgeCap * sizeof(int));
+      assert(g->arcPos != NULL);
+   }
+   parallelFor(g->nV, fillEdges, &b);
+   free(b.upper);
+
+   int nSlots = 16;
+   while (nSlots < 2 * total)
+      nSlots *= 2;
+   free(g->slotKey);
+   free(g->slotPos);
+   initIndex(g, nSlots);
+   for (i = 0; i < total; i++) {
+      int j = findSlot(g, edgeKey(g->edgeList[i].v, g->edgeList[i].w));
+      g->slotKey[j] = edgeKey(g->edgeList[i].v, g->edgeList[i].w);
+      g->slotPos[j] = i;
+   }
+}
+
+// build a dense graph from n edges in parallel
+// duplicates (in either direction) are ignored, as by insertEdge
+// n is at most INT_MAX / 2: the edge index needs 2 * #edges slots
+Graph newGraphFromEdges(int V, const Edge edges[], int n) {
+   assert(n >= 0 && n <= INT_MAX / 2 && (n == 0 || edges != NULL));
+   Graph g = newGraph(V);
+   BuildArgs b;
+   b.g = g;
+   b.edges = edges;
+   b.n = n;
+
+   parallelFor(n, setBits, &b);
+   buildEdgeIndex(g);
+   return g;
+}
+
+// build a sparse graph from n edges in parallel
+// arcs are partitioned by source vertex, then each adjacency list is
+// sorted and deduplicated; all lists share one pool
+// n is at most INT_MAX / 2, as every edge gives two arcs
+Graph newSparseGraphFromEdges(int V, const Edge edges[], int n) {
+   assert(n >= 0 && n <= INT_MAX / 2 && (n == 0 || edges != NULL));
+   Graph g = newSparseGraph(V);
+   BuildArgs b;
+   b.g = g;
+   b.edges = edges;
+   b.n = n;
+   b.start = malloc((V + 1) * sizeof(int));
+   b.key = malloc((2 * (size_t)n + 1) * sizeof(int));
+   b.order = malloc((2 * (size_t)n + 1) * sizeof(int));
+   b.nbr = malloc((2 * (size_t)n + 1) * sizeof(Vertex));
+   assert(b.start != NULL && b.key != NULL && b.order != NULL && b.nbr != NULL);
+
+   parallelFor(n, arcSources, &b);
+   parallelPartition(2 * n, b.key, V, b.start, b.order);
+   free(b.key);
+   parallelFor(V, gatherLists, &b);
+
+   int v;
+   size_t total = 0;
+   for (v = 0; v < V; v++)
+      total += g->deg[v];
+   g->poolLen = total;
+   g->pool = malloc((total > 0 ? total : 1) * sizeof(Vertex));
+   assert(g->pool != NULL);
+   total = 0;
+   for (v = 0; v < V; v++) {
+      g->adj[v] = (g->deg[v] > 0) ? g->pool + total : NULL;
+      total += g->deg[v];
+   }
+   parallelFor(V, copyLists, &b);
+
+   free(b.start);
+   free(b.order);
+   free(b.nbr);
+   buildEdgeIndex(g);
+   return g;
+}
+
+// binary file format
+
+#define GRAPH_MAGIC   "9024GRPH"
+#define GRAPH_VERSION 2   // 2: removed vertices are saved (SEC_FREE)
+
+enum { SEC_BITS, SEC_DEG, SEC_NBR, SEC_ARCPOS, SEC_EDGES, SEC_KEYS, SEC_POS, SEC_FREE, NUM_SECTIONS };
+
+// file = header, then each array at an 8-byte aligned offset, ready to be mapped
+typedef struct {
+   char     magic[8];
+   uint32_t version;
+   uint32_t sparse;
+   int32_t  nV, nE, nWords, nSlots;
+   uint64_t poolLen;               // #entries in SEC_NBR
+   uint64_t nFree;                 // #entries in SEC_FREE, the stack of removed vertices
+   uint64_t offset[NUM_SECTIONS];  // byte offset of each array
+   uint64_t fileLen;
+} GraphFileHeader;
+
+// append len bytes at the next 8-byte boundary, recording where they went
+static bool writeSection(FILE *fp, const void *data, size_t len, uint64_t *offset) {
+   static const char zero[8] = { 0 };
+   long pos = ftell(fp);
+   if (pos < 0 || fwrite(zero, 1, (8 - pos % 8) % 8, fp) != (size_t)((8 - pos % 8) % 8))
+      return false;
+   *offset = (uint64_t)ftell(fp);
+   return len == 0 || fwrite(data, 1, len, fp) == len;
+}
+
+// write g to a file that loadGraph can map; returns 0 on success, -1 on I/O error
+int saveGraph(Graph g, const char *path) {
+   assert(g != NULL && path != NULL);
+   FILE *fp = fopen(path, "wb");
+   if (fp == NULL)
+      return -1;
+
+   GraphFileHeader h;
+   memset(&h, 0, sizeof(h));
+   memcpy(h.magic, GRAPH_MAGIC, 8);
+   h.version = GRAPH_VERSION;
+   h.sparse = g->sparse;
+   h.nV = g->nV;
+   h.nE = g->nE;
+   h.nWords = g->nWords;
+   h.nSlots = g->nSlots;
+   h.nFree = g->nFree;
+
+   bool ok = fwrite(&h, sizeof(h), 1, fp) == 1;
+   if (g->sparse) {
+      int v;
+      ok = ok && writeSection(fp, g->deg, g->nV * sizeof(int), &h.offset[SEC_DEG]);
+      ok = ok && writeSection(fp, NULL, 0, &h.offset[SEC_NBR]);
+      for (v = 0; ok && v < g->nV; v++) {   // adjacency lists back to back (CSR)
+         ok = g->deg[v] == 0 || fwrite(g->adj[v], sizeof(Vertex), g->deg[v], fp) == (size_t)g->deg[v];
+         h.poolLen += g->deg[v];
+      }
+      ok = ok && writeSection(fp, g->arcPos, 2 * (size_t)g->nE * sizeof(int), &h.offset[SEC_ARCPOS]);
+   } else {
+      ok = ok && writeSection(fp, g->bits, (size_t)g->nV * g->nWords * sizeof(uint64_t), &h.offset[SEC_BITS]);
+   }
+   ok = ok && writeSection(fp, g->edgeList, g->nE * sizeof(Edge), &h.offset[SEC_EDGES]);
+   ok = ok && writeSection(fp, g->slotKey, g->nSlots * sizeof(uint64_t), &h.offset[SEC_KEYS]);
+   ok = ok && writeSection(fp, g->slotPos, g->nSlots * sizeof(int), &h.offset[SEC_POS]);
+   ok = ok && writeSection(fp, g->freeIds, g->nFree * sizeof(Vertex), &h.offset[SEC_FREE]);
+   if (ok) {   // now that the offsets are known, rewrite the header
+      h.fileLen = (uint64_t)ftell(fp);
+      ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, fp) == 1;
+   }
+   if (fclose(fp) != 0)
+      ok = false;
+   return ok ? 0 : -1;
+}
+
+// does an array of count items of the given size at offset lie inside the file?
+// offsets must also be 8-byte aligned and come after the header
+static bool sectionFits(uint64_t offset, uint64_t count, size_t size, uint64_t fileLen) {
+   return offset % 8 == 0 && offset >= sizeof(GraphFileHeader) && offset <= fileLen &&
+          count <= (fileLen - offset) / size;
+}
+
+// check everything loadGraph takes from the header before any array is used:
+// counts, the index size and that each section lies inside the file;
+// for sparse graphs the degrees must also add up to the pool length
+// (array contents beyond that are trusted, as checking them would cost O(V + E))
+static bool headerValid(const GraphFileHeader *h, const char *base) {
+   uint64_t len = h->fileLen;
+   if (h->sparse > 1 || h->nV < 0 || h->nE < 0 || h->nWords < 0 ||
+       h->nSlots <= h->nE || (h->nSlots & (h->nSlots - 1)) != 0)
+      return false;
+   if (!sectionFits(h->offset[SEC_EDGES], h->nE, sizeof(Edge), len) ||
+       !sectionFits(h->offset[SEC_KEYS], h->nSlots, sizeof(uint64_t), len) ||
+       !sectionFits(h->offset[SEC_POS], h->nSlots, sizeof(int), len) ||
+       h->nFree > (uint64_t)h->nV || !sectionFits(h->offset[SEC_FREE], h->nFree, sizeof(Vertex), len))
+      return false;
+   if (!h->sparse)
+      return h->nWords >= (h->nV + WORD_BITS - 1) / WORD_BITS &&
+             sectionFits(h->offset[SEC_BITS], (uint64_t)h->nV * h->nWords, sizeof(uint64_t), len);
+
+   if (!sectionFits(h->offset[SEC_DEG], h->nV, sizeof(int), len) ||
+       !sectionFits(h->offset[SEC_NBR], h->poolLen, sizeof(Vertex), len) ||
+       !sectionFits(h->offset[SEC_ARCPOS], 2 * (uint64_t)h->nE, sizeof(int), len))
+      return false;
+   const int *deg = (const int *)(base + h->offset[SEC_DEG]);
+   uint64_t total = 0;
+   int v;
+   for (v = 0; v < h->nV; v++) {
+      if (deg[v] < 0)
+         return false;
+      total += deg[v];
+   }
+   return total == h->poolLen;
+}
+
+// map a file written by saveGraph read-only; the graph's arrays point straight
+// into the mapping, so loading costs O(V) for sparse graphs and for graphs with
+// removed vertices, and O(1) otherwise,
+// and processes loading the same file share its pages
+// returns NULL if the file cannot be read, is not a graph file or its header
+// does not match its contents
+// the result is read-only (insertEdge/removeEdge/deleteEdges assert);
+// copyGraph gives a writable copy
+Graph loadGraph(const char *path) {
+   assert(path != NULL);
+   int fd = open(path, O_RDONLY);
+   if (fd < 0)
+      return NULL;
+   struct stat st;
+   if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GraphFileHeader)) {
+      close(fd);
+      return NULL;
+   }
+   void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED)
+      return NULL;
+
+   const GraphFileHeader *h = map;
+   if (memcmp(h->magic, GRAPH_MAGIC, 8) != 0 || h->version != GRAPH_VERSION ||
+       h->fileLen != (uint64_t)st.st_size || !headerValid(h, map)) {
+      munmap(map, st.st_size);
+      return NULL;
+   }
+
+   Graph g = malloc(sizeof(GraphRep));
+   assert(g != NULL);
+   char *base = map;
+   g->map = map;
+   g->mapLen = st.st_size;
+   g->sparse = h->sparse;
+   g->nV = h->nV;
+   g->nE = h->nE;
+   g->nWords = h->nWords;
+   g->nSlots = h->nSlots;
+   g->edgeList = (Edge *)(base + h->offset[SEC_EDGES]);
+   g->edgeCap = g->nE;
+   g->slotKey = (uint64_t *)(base + h->offset[SEC_KEYS]);
+   g->slotPos = (int *)(base + h->offset[SEC_POS]);
+   g->bits = NULL;
+   g->adj = NULL;
+   g->deg = g->cap = NULL;
+   g->pool = NULL;
+   g->poolLen = 0;
+   g->arcPos = NULL;
+   g->vCap = g->nV;
+   g->removed = NULL;
+   g->freeIds = (Vertex *)(base + h->offset[SEC_FREE]);
+   g->nFree = g->freeCap = h->nFree;
+
+   if (g->nFree > 0) {   // removed flags from the free stack, which must name distinct vertices
+      int i;
+      g->removed = calloc(g->nV, sizeof(bool));
+      assert(g->removed != NULL);
+      for (i = 0; i < g->nFree; i++) {
+         Vertex v = g->freeIds[i];
+         if (v < 0 || v >= g->nV || g->removed[v]) {
+            free(g->removed);
+            free(g);
+            munmap(map, st.st_size);
+            return NULL;
+         }
+         g->removed[v] = true;
+      }
+   }
+
+   if (g->sparse) {
+      int v;
+      g->deg = g->cap = (int *)(base + h->offset[SEC_DEG]);
+      g->pool = (Vertex *)(base + h->offset[SEC_NBR]);
+      g->poolLen = h->poolLen;
+      g->arcPos = (int *)(base + h->offset[SEC_ARCPOS]);
+      g->adj = malloc((g->nV + 1) * sizeof(Vertex *));
+      assert(g->adj != NULL);
+      Vertex *next = g->pool;
+      for (v = 0; v < g->nV; v++) {
+         g->adj[v] = next;
+         next += g->deg[v];
+      }
+   } else {
+      g->bits = (uint64_t *)(base + h->offset[SEC_BITS]);
+   }
+   return g;
+}
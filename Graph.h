@@ -1,5 +1,9 @@
 // Graph ADT interface ... COMP9024 25T1
+#ifndef GRAPH_H
+#define GRAPH_H
+
 #include <stdbool.h>
+#include <stdint.h>
 
 typedef struct GraphRep *Graph;
 
@@ -12,7 +16,10 @@ typedef struct Edge {
    Vertex w;
 } Edge;
 
-Graph newGraph(int);
+Graph newGraph(int);                 // dense graph (bit matrix)
+Graph newSparseGraph(int);           // sparse graph (adjacency lists)
+Graph newGraphFromEdges(int V, const Edge edges[], int n);        // bulk, parallel builds
+Graph newSparseGraphFromEdges(int V, const Edge edges[], int n);  // of the two above
 int   numOfVertices(Graph);
 void  insertEdge(Graph, Edge);
 void  removeEdge(Graph, Edge);
@@ -24,4 +31,42 @@ Edge  randomEdge(Graph g);           // return a random element from the array o
 bool  incident(Edge e1, Edge e2);    // check if e1 and e2 have an endpoint in common
 Graph deleteEdges(Graph g, Edge e);  // delete all edges from g that have at least one endpoint in common with e
 Graph copyGraph(Graph g);            // return a newly created graph that is an exact copy of g
-bool  graphIsEmpty(Graph g);         // check if graph g has no edges
\ No newline at end of file
+bool  graphIsEmpty(Graph g);         // check if graph g has no edges
+
+// vertices can be added at any time: amortised O(1) for sparse graphs, O(V/64) for dense ones
+// a removed vertex loses its edges and its id is handed out again by a later addVertex;
+// until then it stays in the graph as an isolated vertex that takes no new edges
+Vertex addVertex(Graph g);           // new isolated vertex
+void   removeVertex(Graph g, Vertex v);
+
+// binary files: saveGraph returns 0 on success, -1 on I/O error;
+// loadGraph maps the file read-only (NULL if unreadable) and the graph it
+// returns cannot be modified, use copyGraph for a writable copy;
+// removed vertices are saved too, so the copy's addVertex reuses them
+int   saveGraph(Graph g, const char *path);
+Graph loadGraph(const char *path);
+
+// iterate over the neighbours of v in O(deg(v)) (O(V/64 + deg(v)) for dense graphs):
+//    NeighbourIter it;
+//    Vertex w;
+//    for (neighbours(g, v, &it); nextNeighbour(&it, &w); ) ...
+typedef struct NeighbourIter {
+   Graph    g;
+   Vertex   v;
+   int      pos;
+   uint64_t word;
+} NeighbourIter;
+
+void  neighbours(Graph g, Vertex v, NeighbourIter *it);
+bool  nextNeighbour(NeighbourIter *it, Vertex *w);
+
+// adjacency rows are bit-packed, 64 vertices per word
+int   rowWords(Graph g);                             // #words per adjacency row
+const uint64_t *graphRow(Graph g, Vertex v);         // bit w set iff v-w is an edge (dense only)
+void  rowOr(Graph g, Vertex v, uint64_t set[]);      // set |= neighbours of v
+void  rowAnd(Graph g, Vertex v, uint64_t set[]);     // set &= neighbours of v
+int   rowCount(const uint64_t set[], int nWords);    // #bits set in set
+int   degree(Graph g, Vertex v);                     // #neighbours of v
+int   commonNeighbours(Graph g, Vertex v, Vertex w); // #vertices adjacent to both v and w
+
+#endif
@@ -0,0 +1,130 @@
+// Indexed Min-Heap ADT implementation ... COMP9024 25T1
+// binary heap in an array, plus pos[item] = index of item in the heap (-1 if absent)
+
+#include "IHeap.h"
+#include <assert.h>
+#include <stdlib.h>
+
+typedef struct {
+   int key;
+   int item;
+} HeapNode;
+
+typedef struct IHeapRep {
+   HeapNode *node;   // node[0..size-1] is a min-heap on key
+   int      *pos;    // pos[item] = index in node[], or -1
+   int       size;
+   int       n;      // items are 0..n-1
+} IHeapRep;
+
+IHeap newIHeap(int n) {
+   assert(n >= 0);
+   IHeap h = malloc(sizeof(IHeapRep));
+   assert(h != NULL);
+   h->node = malloc((n + 1) * sizeof(HeapNode));
+   h->pos = malloc((n + 1) * sizeof(int));
+   assert(h->node != NULL && h->pos != NULL);
+   h->size = 0;
+   h->n = n;
+   int i;
+   for (i = 0; i < n; i++)
+      h->pos[i] = -1;
+   return h;
+}
+
+void dropIHeap(IHeap h) {
+   assert(h != NULL);
+   free(h->node);
+   free(h->pos);
+   free(h);
+}
+
+void IHeapClear(IHeap h) {
+   int i;
+   for (i = 0; i < h->size; i++)
+      h->pos[h->node[i].item] = -1;
+   h->size = 0;
+}
+
+bool IHeapIsEmpty(IHeap h) {
+   return (h->size == 0);
+}
+
+int IHeapSize(IHeap h) {
+   return h->size;
+}
+
+bool IHeapContains(IHeap h, int item) {
+   assert(item >= 0 && item < h->n);
+   return (h->pos[item] >= 0);
+}
+
+int IHeapKey(IHeap h, int item) {
+   assert(IHeapContains(h, item));
+   return h->node[h->pos[item]].key;
+}
+
+// move the node at index i up/down to its place; the hole moves, the node is written once
+static void siftUp(IHeap h, int i) {
+   HeapNode x = h->node[i];
+   while (i > 0) {
+      int parent = (i - 1) / 2;
+      if (h->node[parent].key <= x.key)
+         break;
+      h->node[i] = h->node[parent];
+      h->pos[h->node[i].item] = i;
+      i = parent;
+   }
+   h->node[i] = x;
+   h->pos[x.item] = i;
+}
+
+static void siftDown(IHeap h, int i) {
+   HeapNode x = h->node[i];
+   for (;;) {
+      int child = 2 * i + 1;
+      if (child >= h->size)
+         break;
+      if (child + 1 < h->size && h->node[child + 1].key < h->node[child].key)
+         child++;
+      if (x.key <= h->node[child].key)
+         break;
+      h->node[i] = h->node[child];
+      h->pos[h->node[i].item] = i;
+      i = child;
+   }
+   h->node[i] = x;
+   h->pos[x.item] = i;
+}
+
+void IHeapPush(IHeap h, int item, int key) {
+   assert(item >= 0 && item < h->n);
+   int i = h->pos[item];
+   if (i < 0) {   // new item at the end
+      i = h->size++;
+      h->node[i].item = item;
+      h->node[i].key = key;
+      siftUp(h, i);
+   } else {       // change key in place
+      int old = h->node[i].key;
+      h->node[i].key = key;
+      if (key < old)
+         siftUp(h, i);
+      else
+         siftDown(h, i);
+   }
+}
+
+int IHeapPop(IHeap h, int *key) {
+   assert(h->size > 0);
+   HeapNode top = h->node[0];
+   h->pos[top.item] = -1;
+   h->size--;
+   if (h->size > 0) {   // last node fills the root
+      h->node[0] = h->node[h->size];
+      siftDown(h, 0);
+   }
+   if (key != NULL)
+      *key = top.key;
+   return top.item;
+}
@@ -0,0 +1,16 @@
+// Indexed Min-Heap ADT interface ... COMP9024 25T1
+// items are ints 0..n-1, each queued at most once with an int key;
+// membership and key lookups are O(1), insert/update/remove-min O(log n)
+#include <stdbool.h>
+
+typedef struct IHeapRep *IHeap;
+
+IHeap newIHeap(int n);                      // empty heap for items 0..n-1
+void  dropIHeap(IHeap);                     // remove unwanted heap
+void  IHeapClear(IHeap);                    // remove all items, O(#items)
+bool  IHeapIsEmpty(IHeap);                  // check whether heap is empty
+int   IHeapSize(IHeap);                     // #items in heap
+bool  IHeapContains(IHeap, int item);       // check whether item is in heap
+int   IHeapKey(IHeap, int item);            // key of an item in heap
+void  IHeapPush(IHeap, int item, int key);  // insert item, or change its key if already in heap
+int   IHeapPop(IHeap, int *key);            // remove item with smallest key (stored in *key if not NULL)
@@ -9,8 +9,22 @@ typedef struct Node {
    struct Node *next; 
 } Node;
 
+static pool nodePool = NULL;   // NULL: nodes are malloc'd
+
+void useListPool(pool p) {
+   assert(p == NULL || poolObjectSize(p) >= sizeof(Node));
+   nodePool = p;
+}
+
+static void freeNode(Node *n) {
+   if (nodePool != NULL)
+      poolFree(nodePool, n);
+   else
+      free(n);
+}
+
 Node *makeNode(int n) {
-   Node *new = malloc(sizeof(Node));
+   Node *new = (nodePool != NULL) ? poolAlloc(nodePool) : malloc(sizeof(Node));
    assert(new != NULL);
    new->v = n;
    new->next = NULL;
@@ -27,40 +41,37 @@ List insertLL(List L, int n) {
    return new;
 }
 
+// all loops below are iterative, so long lists cannot overflow the call stack
+
 List deleteLL(List L, int n) {
-   if (L == NULL) {
-      return L;
-   } else if (L->v == n) {
-      Node *p = L->next;
-      free(L);
-      return p;
-   } else {
-      L->next = deleteLL(L->next, n);
-      return L;
+   Node **p = &L;   // link that points to the current node
+   while (*p != NULL && (*p)->v != n)
+      p = &(*p)->next;
+   if (*p != NULL) {
+      Node *old = *p;
+      *p = old->next;
+      freeNode(old);
    }
+   return L;
 }
 
 bool inLL(List L, int n) {
-   if (L == NULL)
-      return false;
-   if (L->v == n)
-     return true;
-
-   return inLL(L->next, n);
+   for (; L != NULL; L = L->next)
+      if (L->v == n)
+         return true;
+   return false;
 }
 
 void showLL(List L) {
-   if (L == NULL)
-      putchar('\n');
-   else {
+   for (; L != NULL; L = L->next)
       printf("%d ", L->v);
-      showLL(L->next);
-   }
+   putchar('\n');
 }
 
 void freeLL(List L) {
-   if (L != NULL) {
-      freeLL(L->next);
-      free(L);
+   while (L != NULL) {
+      Node *next = L->next;
+      freeNode(L);
+      L = next;
    }
 }
\ No newline at end of file
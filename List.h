@@ -1,10 +1,19 @@
 // Linked list interface ... COMP9024 25T1
 #include <stdbool.h>
+#include "Pool.h"
 
 typedef struct Node *List;
 
+// insertLL checks for duplicates, so every operation is O(length);
+// UList.h keeps larger sets (blocked scan or hashed)
+
 List insertLL(List, int);
 List deleteLL(List, int);
 bool inLL(List, int);
 void freeLL(List);
-void showLL(List);
\ No newline at end of file
+void showLL(List);
+
+// nodes come from p instead of malloc (NULL: back to malloc); only switch while
+// no list exists; poolReset(p) then frees every list at once, without freeLL
+// a node is an int and a pointer, so newPool(2 * sizeof(void *)) is large enough
+void useListPool(pool p);
\ No newline at end of file
@@ -0,0 +1,104 @@
+// Multi-Producer/Multi-Consumer Queue ADT implementation ... COMP9024 25T1
+// every cell carries a sequence number saying whose turn it is:
+//    seq == pos          free for the producer that claims position pos
+//    seq == pos + 1      filled, ready for the consumer that claims pos
+//    seq == pos + size   free again, for the producer one lap later
+// producers and consumers claim positions with a CAS on their own counter
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <sched.h>
+#include "MPMCQueue.h"
+
+#define CACHE_LINE 64
+#define SPIN       64   // failed attempts before a waiting thread starts yielding
+
+typedef struct {
+   uint64_t seq;
+   void    *item;
+} Cell;
+
+typedef struct MPMCQueueRep {
+   Cell    *cell;
+   uint64_t mask;                              // size - 1
+   _Alignas(CACHE_LINE) uint64_t enqueuePos;   // next position to fill
+   _Alignas(CACHE_LINE) uint64_t dequeuePos;   // next position to empty
+} MPMCQueueRep;
+
+mpmcQueue newMPMCQueue(int capacity) {
+   assert(capacity > 0);
+   mpmcQueue Q = aligned_alloc(CACHE_LINE, sizeof(MPMCQueueRep));
+   assert(Q != NULL);
+   uint64_t size = 2, i;   // with a single cell "filled" and "free next lap" would look alike
+   while (size < (uint64_t)capacity)
+      size *= 2;
+   Q->cell = malloc(size * sizeof(Cell));
+   assert(Q->cell != NULL);
+   for (i = 0; i < size; i++)
+      Q->cell[i].seq = i;
+   Q->mask = size - 1;
+   Q->enqueuePos = Q->dequeuePos = 0;
+   return Q;
+}
+
+void dropMPMCQueue(mpmcQueue Q) {
+   free(Q->cell);
+   free(Q);
+}
+
+bool MPMCTryEnqueue(mpmcQueue Q, void *item) {
+   uint64_t pos = __atomic_load_n(&Q->enqueuePos, __ATOMIC_RELAXED);
+   for (;;) {
+      Cell *c = &Q->cell[pos & Q->mask];
+      int64_t diff = (int64_t)(__atomic_load_n(&c->seq, __ATOMIC_ACQUIRE) - pos);
+      if (diff == 0) {          // cell is free: try to claim pos
+         if (__atomic_compare_exchange_n(&Q->enqueuePos, &pos, pos + 1, true,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            c->item = item;
+            __atomic_store_n(&c->seq, pos + 1, __ATOMIC_RELEASE);
+            return true;
+         }                      // lost the race: pos now holds the current value
+      } else if (diff < 0) {    // cell still holds the item from one lap ago
+         return false;          // full
+      } else {                  // another producer got pos first
+         pos = __atomic_load_n(&Q->enqueuePos, __ATOMIC_RELAXED);
+      }
+   }
+}
+
+bool MPMCTryDequeue(mpmcQueue Q, void **item) {
+   uint64_t pos = __atomic_load_n(&Q->dequeuePos, __ATOMIC_RELAXED);
+   for (;;) {
+      Cell *c = &Q->cell[pos & Q->mask];
+      int64_t diff = (int64_t)(__atomic_load_n(&c->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+      if (diff == 0) {          // cell is filled: try to claim pos
+         if (__atomic_compare_exchange_n(&Q->dequeuePos, &pos, pos + 1, true,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *item = c->item;
+            __atomic_store_n(&c->seq, pos + Q->mask + 1, __ATOMIC_RELEASE);
+            return true;
+         }
+      } else if (diff < 0) {    // not filled yet
+         return false;          // empty
+      } else {                  // another consumer got pos first
+         pos = __atomic_load_n(&Q->dequeuePos, __ATOMIC_RELAXED);
+      }
+   }
+}
+
+void MPMCEnqueue(mpmcQueue Q, void *item) {
+   int tries = 0;
+   while (!MPMCTryEnqueue(Q, item))
+      if (++tries > SPIN)
+         sched_yield();
+}
+
+void *MPMCDequeue(mpmcQueue Q) {
+   void *item;
+   int tries = 0;
+   while (!MPMCTryDequeue(Q, &item))
+      if (++tries > SPIN)
+         sched_yield();
+   return item;
+}
@@ -0,0 +1,13 @@
+// Multi-Producer/Multi-Consumer Queue ADT header file ... COMP9024 25T1
+// bounded lock-free ring of pointers that any number of threads
+// may enqueue to and dequeue from at the same time
+#include <stdbool.h>
+
+typedef struct MPMCQueueRep *mpmcQueue;
+
+mpmcQueue newMPMCQueue(int capacity);            // empty queue for capacity items (rounded up to a power of 2)
+void      dropMPMCQueue(mpmcQueue);              // remove unwanted queue
+bool      MPMCTryEnqueue(mpmcQueue, void *item); // insert at end, false if the queue is full
+bool      MPMCTryDequeue(mpmcQueue, void **item);// remove from front into *item, false if empty
+void      MPMCEnqueue(mpmcQueue, void *item);    // insert at end, waiting while the queue is full
+void     *MPMCDequeue(mpmcQueue);                // remove from front, waiting while the queue is empty
@@ -0,0 +1,139 @@
+// Minimum spanning trees of a WGraph ... COMP9024 25T1
+
+#include "MST.h"
+#include "IHeap.h"
+#include "UnionFind.h"
+#include "Parallel.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+int primMST(Graph g, Edge tree[], long long *total) {
+   assert(g != NULL && tree != NULL);
+   int nV = numOfVertices(g), n = 0, s;
+   long long sum = 0;
+
+   IHeap heap = newIHeap(nV);
+   Vertex *pred = malloc((nV + 1) * sizeof(Vertex));
+   bool   *done = calloc(nV + 1, sizeof(bool));
+   assert(pred != NULL && done != NULL);
+
+   for (s = 0; s < nV; s++) {   // one tree per component
+      if (done[s])
+         continue;
+      pred[s] = -1;
+      IHeapPush(heap, s, 0);
+      while (!IHeapIsEmpty(heap)) {
+         int key, weight;
+         Vertex v = IHeapPop(heap, &key), w;
+         done[v] = true;
+         if (pred[v] >= 0) {
+            tree[n].v = pred[v];
+            tree[n].w = v;
+            tree[n].weight = key;
+            n++;
+            sum += key;
+         }
+
+         // key of w = lightest edge from the tree to w seen so far
+         NeighbourIter it;
+         for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); ) {
+            if (!done[w] && (!IHeapContains(heap, w) || weight < IHeapKey(heap, w))) {
+               pred[w] = v;
+               IHeapPush(heap, w, weight);
+            }
+         }
+      }
+   }
+
+   dropIHeap(heap);
+   free(pred);
+   free(done);
+   if (total != NULL)
+      *total = sum;
+   return n;
+}
+
+typedef struct {
+   Graph g;
+   int  *start;   // edges from v go to edges[start[v] ..]
+   Edge *edges;
+} GatherArgs;
+
+// #edges (v,w) with v < w for each v
+static void countEdges(int lo, int hi, int worker, void *arg) {
+   GatherArgs *a = arg;
+   int v, w, weight;
+   for (v = lo; v < hi; v++) {
+      int n = 0;
+      NeighbourIter it;
+      for (neighbours(a->g, v, &it); nextNeighbour(&it, &w, &weight); )
+         n += (v < w);
+      a->start[v] = n;
+   }
+   (void)worker;
+}
+
+static void gatherEdges(int lo, int hi, int worker, void *arg) {
+   GatherArgs *a = arg;
+   int v, w, weight;
+   for (v = lo; v < hi; v++) {
+      Edge *e = a->edges + a->start[v];
+      NeighbourIter it;
+      for (neighbours(a->g, v, &it); nextNeighbour(&it, &w, &weight); ) {
+         if (v < w) {
+            e->v = v;
+            e->w = w;
+            e->weight = weight;
+            e++;
+         }
+      }
+   }
+   (void)worker;
+}
+
+// by weight; equal weights by endpoints, so the tree does not depend on the thread count
+static int compareEdges(const void *a, const void *b) {
+   const Edge *x = a, *y = b;
+   if (x->weight != y->weight)
+      return (x->weight < y->weight) ? -1 : 1;
+   if (x->v != y->v)
+      return (x->v < y->v) ? -1 : 1;
+   return (x->w > y->w) - (x->w < y->w);
+}
+
+int kruskalMST(Graph g, Edge tree[], long long *total) {
+   assert(g != NULL && tree != NULL);
+   int nV = numOfVertices(g), nE = 0, n = 0, v, i;
+   long long sum = 0;
+
+   GatherArgs a;
+   a.g = g;
+   a.start = malloc((nV + 1) * sizeof(int));
+   assert(a.start != NULL);
+   parallelFor(nV, countEdges, &a);
+   for (v = 0; v < nV; v++) {   // counts -> offsets
+      int c = a.start[v];
+      a.start[v] = nE;
+      nE += c;
+   }
+   a.edges = malloc((nE + 1) * sizeof(Edge));
+   assert(a.edges != NULL);
+   parallelFor(nV, gatherEdges, &a);
+   parallelSort(a.edges, nE, sizeof(Edge), compareEdges);
+
+   UnionFind uf = newUnionFind(nV);
+   for (i = 0; i < nE && n < nV - 1; i++) {
+      if (ufUnion(uf, a.edges[i].v, a.edges[i].w)) {
+         tree[n++] = a.edges[i];
+         sum += a.edges[i].weight;
+      }
+   }
+
+   dropUnionFind(uf);
+   free(a.edges);
+   free(a.start);
+   if (total != NULL)
+      *total = sum;
+   return n;
+}
@@ -0,0 +1,16 @@
+// Minimum spanning trees of a WGraph ... COMP9024 25T1
+// g is taken as undirected: every edge must be stored in both directions
+// if g is not connected, the result is a minimum spanning forest
+#include "WGraph.h"
+
+// Prim's algorithm with an indexed heap, O((V+E) log V); meant for dense graphs,
+// where Kruskal would have to sort all V^2/2 edges
+// tree edges are written to tree[] (room for numOfVertices(g)-1 edges) as (parent, child, weight)
+// returns the number of tree edges; their total weight is stored in *total if total is not NULL
+int primMST(Graph g, Edge tree[], long long *total);
+
+// Kruskal's algorithm for sparse graphs: the edges are gathered and sorted in
+// parallel (Parallel.h), then added lightest first, skipping edges that would
+// close a cycle (UnionFind.h); O(E log E)
+// tree edges are written as (v, w, weight) with v < w; arguments and result as for primMST
+int kruskalMST(Graph g, Edge tree[], long long *total);
@@ -1,55 +1,228 @@
-// Priority Queue ADO implementation ... COMP9024 25T1
+// Priority Queue ADT implementation ... COMP9024 25T1
+// d-ary min-heap of vertices ordered by priority[], plus pos[v] = index of v
+// in the heap (-1 if not queued); join, leave and update are O(log n)
+// the global queue starts out as the original unordered array that every
+// leave scans, since its callers may lower priority[v] without telling it;
+// the first updatePQueue turns it into a heap until the next PQueueInit
 
 #include "PQueue.h"
 #include <assert.h>
-#include <limits.h>
+#include <stdlib.h>
 
-typedef struct {
-   Vertex item[MAX_NODES];  // array of vertices currently in queue
-   int    length;           // #values currently stored in item[] array
-} PQueueT;
-
-static PQueueT PQueue;      // defines the Priority Queue Object
+typedef struct PQueueRep {
+   Vertex *item;      // item[0..length-1], a heap on priority[item[i]] once ordered
+   int    *pos;       // pos[v] = index of v in item[], or -1
+   int     length;    // #values currently stored in item[] array
+   int     cap;       // vertices 0..cap-1 fit into item[] and pos[]
+   int    *priority;  // array given to the last leave, NULL before the first
+   bool    ordered;   // item[] is a heap on priority[]
+   bool    scan;      // leave scans item[] (global queue before any updatePQueue)
+} PQueueRep;
 
 // set up empty priority queue
-void PQueueInit() {
-   PQueue.length = 0;
+pqueue newPQueue() {
+   pqueue Q = malloc(sizeof(PQueueRep));
+   assert(Q != NULL);
+   Q->item = NULL;
+   Q->pos = NULL;
+   Q->length = 0;
+   Q->cap = 0;
+   Q->priority = NULL;
+   Q->ordered = false;
+   Q->scan = false;
+   return Q;
+}
+
+// remove unwanted priority queue
+void dropPQueue(pqueue Q) {
+   assert(Q != NULL);
+   free(Q->item);
+   free(Q->pos);
+   free(Q);
+}
+
+// remove all vertices, O(#vertices queued)
+void pqClear(pqueue Q) {
+   assert(Q != NULL);
+   int i;
+   for (i = 0; i < Q->length; i++)
+      Q->pos[Q->item[i]] = -1;
+   Q->length = 0;
+   Q->priority = NULL;
+   Q->ordered = false;
+}
+
+// make room for vertex v, doubling the capacity
+static void reserve(pqueue Q, Vertex v) {
+   if (v < Q->cap)
+      return;
+   int cap = (Q->cap == 0) ? MAX_NODES : Q->cap, i;
+   while (cap <= v)
+      cap *= 2;
+   Q->item = realloc(Q->item, cap * sizeof(Vertex));
+   Q->pos = realloc(Q->pos, cap * sizeof(int));
+   assert(Q->item != NULL && Q->pos != NULL);
+   for (i = Q->cap; i < cap; i++)
+      Q->pos[i] = -1;
+   Q->cap = cap;
+}
+
+// a before b; equal priorities go by vertex, so the order does not depend on history
+static inline bool before(pqueue Q, Vertex a, Vertex b) {
+   int pa = Q->priority[a], pb = Q->priority[b];
+   return pa < pb || (pa == pb && a < b);
+}
+
+// move the vertex at index i up/down to its place
+static void siftUp(pqueue Q, int i) {
+   Vertex x = Q->item[i];
+   while (i > 0) {
+      int parent = (i - 1) / PQ_ARITY;
+      if (!before(Q, x, Q->item[parent]))
+         break;
+      Q->item[i] = Q->item[parent];
+      Q->pos[Q->item[i]] = i;
+      i = parent;
+   }
+   Q->item[i] = x;
+   Q->pos[x] = i;
+}
+
+static void siftDown(pqueue Q, int i) {
+   Vertex x = Q->item[i];
+   for (;;) {
+      int first = PQ_ARITY * i + 1, best = -1, c;
+      for (c = first; c < first + PQ_ARITY && c < Q->length; c++)
+         if (best < 0 || before(Q, Q->item[c], Q->item[best]))
+            best = c;
+      if (best < 0 || !before(Q, Q->item[best], x))
+         break;
+      Q->item[i] = Q->item[best];
+      Q->pos[Q->item[i]] = i;
+      i = best;
+   }
+   Q->item[i] = x;
+   Q->pos[x] = i;
 }
 
 // insert vertex v into priority queue
-// no effect if v is already in the queue
-void joinPQueue(int v) {
-   assert(PQueue.length < MAX_NODES);                // ensure queue ADO is not full
-   int i = 0;
-   while (i < PQueue.length && PQueue.item[i] != v)  // check if v already in queue
-      i++;
-   if (i == PQueue.length) {                         // v not found => add it at the end
-      PQueue.item[PQueue.length] = v;
-      PQueue.length++;
+// if v is already in the queue, its position is updated to its current priority
+void pqJoin(pqueue Q, Vertex v) {
+   assert(Q != NULL && v >= 0);
+   reserve(Q, v);
+   if (Q->pos[v] >= 0) {
+      pqUpdate(Q, v);
+      return;
+   }
+   Q->item[Q->length] = v;       // v not found => add it at the end
+   Q->pos[v] = Q->length;
+   Q->length++;
+   if (Q->ordered)
+      siftUp(Q, Q->length - 1);
+}
+
+// the original leave: scan for the lowest priority[v], ties go to the vertex
+// that has been in item[] longest, and fill the gap with the last item; O(n)
+static Vertex scanLeave(pqueue Q, int priority[]) {
+   int i, bestIndex = 0;
+   for (i = 1; i < Q->length; i++)
+      if (priority[Q->item[i]] < priority[Q->item[bestIndex]])
+         bestIndex = i;
+   Vertex best = Q->item[bestIndex];
+   Q->pos[best] = -1;
+   Q->length--;
+   if (bestIndex < Q->length) {
+      Q->item[bestIndex] = Q->item[Q->length];
+      Q->pos[Q->item[bestIndex]] = bestIndex;
+   }
+   return best;
+}
+
+// priority[v] has changed while v was queued
+void pqUpdate(pqueue Q, Vertex v) {
+   assert(pqContains(Q, v));
+   if (Q->ordered) {
+      siftUp(Q, Q->pos[v]);
+      siftDown(Q, Q->pos[v]);
    }
 }
 
-// remove the highest priority vertex from PQueue
-// highest priority = lowest value priority[v]
+// check if v is currently queued
+bool pqContains(pqueue Q, Vertex v) {
+   assert(Q != NULL);
+   return v >= 0 && v < Q->cap && Q->pos[v] >= 0;
+}
+
+// remove the highest priority vertex from Q
+// highest priority = lowest value priority[v], ties go to the smaller vertex
 // returns the removed vertex
-Vertex leavePQueue(int priority[]) {
-   assert(PQueue.length > 0);
+// the heap is built (O(n)) on the first call after newPQueue/pqClear or when
+// a different priority[] array is passed
+Vertex pqLeave(pqueue Q, int priority[]) {
+   assert(Q != NULL && Q->length > 0);
 
-   int i, bestIndex = 0, bestVertex = PQueue.item[0], bestWeight = INT_MAX;
-   for (i = 0; i < PQueue.length; i++) {         // find i with min priority[item[i]]
-      if (priority[PQueue.item[i]] < bestWeight) {
-         bestIndex = i;
-         bestWeight = priority[PQueue.item[i]];
-	 bestVertex = PQueue.item[i];            // vertex with lowest value so far
-      }
+   int i;
+   if (Q->scan)
+      return scanLeave(Q, priority);
+   if (!Q->ordered || priority != Q->priority) {
+      Q->priority = priority;
+      for (i = (Q->length - 2) / PQ_ARITY; i >= 0; i--)
+         siftDown(Q, i);
+      Q->ordered = true;
+   }
+   Vertex best = Q->item[0];
+   Q->pos[best] = -1;
+   Q->length--;
+   if (Q->length > 0) {
+      Q->item[0] = Q->item[Q->length];  // replace dequeued node
+      siftDown(Q, 0);                   // by last element in array
    }
-   PQueue.length--;
-   PQueue.item[bestIndex] = PQueue.item[PQueue.length];  // replace dequeued node
-							 // by last element in array
-   return bestVertex;
+   return best;
+}
+
+// check if priority queue Q is empty
+bool pqIsEmpty(pqueue Q) {
+   assert(Q != NULL);
+   return (Q->length == 0);
+}
+
+// the global Priority Queue Object, created on first use
+static pqueue PQueue = NULL;
+
+// set up empty priority queue
+// as in the original, leave reads priority[] afresh each time, so callers may
+// lower priority[v] of a queued vertex without telling the queue
+void PQueueInit() {
+   if (PQueue == NULL)
+      PQueue = newPQueue();
+   else
+      pqClear(PQueue);
+   PQueue->scan = true;
+}
+
+void joinPQueue(Vertex v) {
+   assert(PQueue != NULL);   // PQueueInit() first
+   pqJoin(PQueue, v);
+}
+
+Vertex leavePQueue(int priority[]) {
+   assert(PQueue != NULL);
+   return pqLeave(PQueue, priority);
 }
 
-// check if priority queue PQueue is empty
 bool PQueueIsEmpty() {
-   return (PQueue.length == 0);
-}
\ No newline at end of file
+   assert(PQueue != NULL);
+   return pqIsEmpty(PQueue);
+}
+
+bool inPQueue(Vertex v) {
+   assert(PQueue != NULL);
+   return pqContains(PQueue, v);
+}
+
+// the caller reports priority changes: from now on leave uses the heap
+void updatePQueue(Vertex v) {
+   assert(PQueue != NULL);
+   PQueue->scan = false;
+   pqUpdate(PQueue, v);
+}
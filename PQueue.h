@@ -1,11 +1,39 @@
-// Priority Queue ADO header ... COMP9024 25T1
+// Priority Queue ADT header ... COMP9024 25T1
 
 #include "WGraph.h"
 #include <stdbool.h>
 
-#define MAX_NODES 1000
+#define MAX_NODES 1000   // initial capacity; queues grow as needed
 
+#ifndef PQ_ARITY
+#define PQ_ARITY 2       // children per heap node, e.g. -DPQ_ARITY=4 for a 4-ary heap
+#endif
+
+// a queue orders vertices by the priority[] array given to leave;
+// after changing priority[v] of a queued vertex, tell the queue with
+// update(v) (or join(v)) before the next leave
+// each queue is independent, so threads can run searches side by side
+// as long as each uses its own queue
+typedef struct PQueueRep *pqueue;
+
+pqueue newPQueue();                      // set up empty priority queue
+void   dropPQueue(pqueue);               // remove unwanted priority queue
+void   pqClear(pqueue);                  // remove all vertices
+void   pqJoin(pqueue, Vertex);           // insert vertex (or update it if queued)
+Vertex pqLeave(pqueue, int priority[]);  // remove vertex with lowest priority[v]
+bool   pqIsEmpty(pqueue);
+bool   pqContains(pqueue, Vertex);       // O(1)
+void   pqUpdate(pqueue, Vertex);         // priority of a queued vertex has changed, O(log n)
+
+// the original single, global queue: wrappers around one shared pqueue
+// (not for use from several threads at once)
+// like the original, leave scans the queue (O(n)) and so sees any change to
+// priority[]; a caller that reports every change of a queued vertex's
+// priority with updatePQueue gets O(log n) heap operations from its first
+// updatePQueue until the next PQueueInit
 void   PQueueInit();
 void   joinPQueue(Vertex);
 Vertex leavePQueue(int[]);
-bool   PQueueIsEmpty();
\ No newline at end of file
+bool   PQueueIsEmpty();
+bool   inPQueue(Vertex);
+void   updatePQueue(Vertex);
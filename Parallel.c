@@ -0,0 +1,234 @@
+// Parallel loop helpers ... COMP9024 25T1
+
+#include "Parallel.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdbool.h>
+
+// read and written atomically: any thread may call setNumWorkers, or be the
+// first to ask numWorkers, while others are starting parallel loops
+static int workers = 0;   // 0 = not yet decided
+
+int numWorkers(void) {
+   int T = __atomic_load_n(&workers, __ATOMIC_RELAXED);
+   if (T == 0) {
+      long n = sysconf(_SC_NPROCESSORS_ONLN);
+      T = (n > 0) ? (int)n : 1;
+      int expected = 0;   // keep a value another thread set in the meantime
+      if (!__atomic_compare_exchange_n(&workers, &expected, T, false,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+         T = expected;
+   }
+   return T;
+}
+
+void setNumWorkers(int n) {
+   assert(n >= 0);
+   __atomic_store_n(&workers, n, __ATOMIC_RELAXED);
+}
+
+typedef struct {
+   void (*body)(int, int, int, void *);
+   void *arg;
+   int   lo, hi, worker;
+} Chunk;
+
+static void *runChunk(void *p) {
+   Chunk *c = p;
+   c->body(c->lo, c->hi, c->worker, c->arg);
+   return NULL;
+}
+
+void parallelFor(int n, void (*body)(int lo, int hi, int worker, void *arg), void *arg) {
+   parallelForWorkers(n, numWorkers(), body, arg);
+}
+
+void parallelForWorkers(int n, int T, void (*body)(int lo, int hi, int worker, void *arg), void *arg) {
+   assert(n >= 0 && T >= 1 && body != NULL);
+   if (n == 0)
+      return;
+
+   if (T > n)
+      T = n;
+   if (T == 1) {
+      body(0, n, 0, arg);
+      return;
+   }
+
+   Chunk     *chunk   = malloc(T * sizeof(Chunk));
+   pthread_t *thread  = malloc(T * sizeof(pthread_t));
+   int       *started = malloc(T * sizeof(int));
+   assert(chunk != NULL && thread != NULL && started != NULL);
+
+   int t;
+   for (t = 0; t < T; t++) {
+      chunk[t].body = body;
+      chunk[t].arg = arg;
+      chunk[t].lo = (int)((long long)t * n / T);
+      chunk[t].hi = (int)((long long)(t + 1) * n / T);
+      chunk[t].worker = t;
+   }
+   // chunk 0 runs on the calling thread, as does any chunk whose thread failed to start
+   for (t = 1; t < T; t++)
+      started[t] = (pthread_create(&thread[t], NULL, runChunk, &chunk[t]) == 0);
+   runChunk(&chunk[0]);
+   for (t = 1; t < T; t++) {
+      if (started[t])
+         pthread_join(thread[t], NULL);
+      else
+         runChunk(&chunk[t]);
+   }
+
+   free(chunk);
+   free(thread);
+   free(started);
+}
+
+typedef struct {
+   int        n, nKeys, T;
+   const int *key;
+   int       *count;   // count[t*nKeys + k] = #items with key k in chunk t
+   int       *order;
+} PartitionArgs;
+
+static void countKeys(int lo, int hi, int worker, void *arg) {
+   PartitionArgs *p = arg;
+   int t, i;
+   for (t = lo; t < hi; t++) {
+      int *count = p->count + (size_t)t * p->nKeys;
+      int from = (int)((long long)t * p->n / p->T), to = (int)((long long)(t + 1) * p->n / p->T);
+      for (i = from; i < to; i++) {
+         assert(p->key[i] >= 0 && p->key[i] < p->nKeys);
+         count[p->key[i]]++;
+      }
+   }
+   (void)worker;
+}
+
+// count[] now holds the first output position for each (chunk, key)
+static void scatterKeys(int lo, int hi, int worker, void *arg) {
+   PartitionArgs *p = arg;
+   int t, i;
+   for (t = lo; t < hi; t++) {
+      int *next = p->count + (size_t)t * p->nKeys;
+      int from = (int)((long long)t * p->n / p->T), to = (int)((long long)(t + 1) * p->n / p->T);
+      for (i = from; i < to; i++)
+         p->order[next[p->key[i]]++] = i;
+   }
+   (void)worker;
+}
+
+void parallelPartition(int n, const int key[], int nKeys, int start[], int order[]) {
+   assert(n >= 0 && nKeys >= 0);
+   PartitionArgs p;
+   p.n = n;
+   p.nKeys = nKeys;
+   p.T = numWorkers();
+   if (p.T > n)
+      p.T = (n > 0) ? n : 1;
+   p.key = key;
+   p.order = order;
+   p.count = calloc((size_t)p.T * nKeys + 1, sizeof(int));
+   assert(p.count != NULL);
+
+   parallelFor(p.T, countKeys, &p);
+
+   // exclusive prefix sum in (key, chunk) order keeps the partition stable
+   int k, t, pos = 0;
+   for (k = 0; k < nKeys; k++) {
+      start[k] = pos;
+      for (t = 0; t < p.T; t++) {
+         int c = p.count[(size_t)t * nKeys + k];
+         p.count[(size_t)t * nKeys + k] = pos;
+         pos += c;
+      }
+   }
+   start[nKeys] = pos;
+
+   parallelFor(p.T, scatterKeys, &p);
+   free(p.count);
+}
+
+typedef struct {
+   char  *src, *dst;
+   size_t size;
+   int  (*cmp)(const void *, const void *);
+   int   *bound;   // run r is items bound[r] .. bound[r+1]-1
+   int    nRuns;
+} SortArgs;
+
+static void sortRuns(int lo, int hi, int worker, void *arg) {
+   SortArgs *s = arg;
+   int r;
+   for (r = lo; r < hi; r++)
+      qsort(s->src + (size_t)s->bound[r] * s->size, s->bound[r + 1] - s->bound[r], s->size, s->cmp);
+   (void)worker;
+}
+
+// merge runs 2p and 2p+1 of src into dst; a lone last run is just copied
+static void mergeRuns(int lo, int hi, int worker, void *arg) {
+   SortArgs *s = arg;
+   size_t size = s->size;
+   int p;
+   for (p = lo; p < hi; p++) {
+      int from = s->bound[2 * p];
+      int mid = s->bound[2 * p + 1];
+      int to = (2 * p + 2 <= s->nRuns) ? s->bound[2 * p + 2] : mid;
+      int l = from, r = mid, k = from;
+      while (l < mid && r < to) {
+         if (s->cmp(s->src + (size_t)r * size, s->src + (size_t)l * size) < 0)
+            memcpy(s->dst + (size_t)k++ * size, s->src + (size_t)r++ * size, size);
+         else
+            memcpy(s->dst + (size_t)k++ * size, s->src + (size_t)l++ * size, size);
+      }
+      memcpy(s->dst + (size_t)k * size, s->src + (size_t)l * size, (size_t)(mid - l) * size);
+      k += mid - l;
+      memcpy(s->dst + (size_t)k * size, s->src + (size_t)r * size, (size_t)(to - r) * size);
+   }
+   (void)worker;
+}
+
+void parallelSort(void *base, int n, size_t size, int (*cmp)(const void *, const void *)) {
+   assert(n >= 0 && size > 0 && cmp != NULL && (n == 0 || base != NULL));
+   int T = numWorkers(), r;
+   if (T > n / 1024)     // below ~1024 items per run threads cost more than they save
+      T = n / 1024;
+   if (T <= 1) {
+      qsort(base, n, size, cmp);
+      return;
+   }
+
+   SortArgs s;
+   s.src = base;
+   s.size = size;
+   s.cmp = cmp;
+   s.nRuns = T;
+   s.bound = malloc((T + 1) * sizeof(int));
+   s.dst = malloc((size_t)n * size);
+   assert(s.bound != NULL && s.dst != NULL);
+   for (r = 0; r <= T; r++)
+      s.bound[r] = (int)((long long)r * n / T);
+
+   parallelFor(T, sortRuns, &s);
+   while (s.nRuns > 1) {
+      int pairs = (s.nRuns + 1) / 2;
+      parallelFor(pairs, mergeRuns, &s);
+      for (r = 0; r < pairs; r++)   // run r is now the merge of runs 2r and 2r+1
+         s.bound[r] = s.bound[2 * r];
+      s.bound[pairs] = n;
+      s.nRuns = pairs;
+      char *t = s.src;
+      s.src = s.dst;
+      s.dst = t;
+   }
+   if (s.src != base) {   // result ended up in the scratch buffer
+      memcpy(base, s.src, (size_t)n * size);
+      free(s.src);
+   } else {
+      free(s.dst);
+   }
+   free(s.bound);
+}
@@ -0,0 +1,25 @@
+// Parallel loop helpers ... COMP9024 25T1
+// work is split across POSIX threads, one contiguous chunk per worker
+
+#include <stddef.h>
+
+int  numWorkers(void);         // #threads used by parallelFor
+void setNumWorkers(int);       // use this many threads (0 = one per online core)
+
+// run body(lo, hi, worker, arg) on chunks [lo,hi) that together cover [0,n)
+// chunk t is [t*n/T, (t+1)*n/T) with T = min(numWorkers(), n), worker = t
+void parallelFor(int n, void (*body)(int lo, int hi, int worker, void *arg), void *arg);
+
+// as parallelFor, but with T = min(T, n) given by the caller rather than read
+// from numWorkers(): use it when body indexes per-worker arrays of T entries,
+// since another thread may change numWorkers() in between
+void parallelForWorkers(int n, int T, void (*body)(int lo, int hi, int worker, void *arg), void *arg);
+
+// stable partition of items 0..n-1 by key[i] in 0..nKeys-1
+// afterwards order[start[k] .. start[k+1]-1] lists the items with key k in index order
+// start[] must hold nKeys+1 ints, order[] n ints
+void parallelPartition(int n, const int key[], int nKeys, int start[], int order[]);
+
+// sort n items of the given size with cmp (as qsort, not stable):
+// each worker sorts one chunk, then sorted runs are merged pairwise in parallel
+void parallelSort(void *base, int n, size_t size, int (*cmp)(const void *, const void *));
@@ -0,0 +1,199 @@
+// Pool allocator for fixed-size objects ... COMP9024 25T1
+// slabs stay linked in allocation order and new objects are carved from the
+// current slab, so a reset just rewinds to the first slab
+// every thread has CACHE_SLOTS thread-local free lists, slot = pool id % CACHE_SLOTS;
+// a list is tagged with its pool's id and reset generation, and a list whose
+// tag no longer matches holds objects that were reset or belong to another pool
+// objects cached by a thread that exits come back at the next reset or drop
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <pthread.h>
+#include "Pool.h"
+
+#define SLAB_BYTES  (64 * 1024)
+#define MIN_PER_SLAB 64
+#define BATCH       32    // objects moved between a thread and the pool at a time
+#define CACHE_SLOTS 8
+
+typedef struct Slab {
+   struct Slab *next;
+   max_align_t  obj[];    // perSlab objects of objSize bytes
+} Slab;
+
+typedef struct PoolRep {
+   size_t          objSize, perSlab;
+   uint64_t        id, gen;    // gen changes with every reset
+   pthread_mutex_t lock;       // guards the fields below
+   void           *free;       // objects handed back by threads, linked through their first word
+   Slab           *first, *last;
+   Slab           *cur;        // slab being carved
+   size_t          used;       // #objects carved from cur
+   struct PoolRep *nextLive;   // all live pools, for flushing evicted thread caches
+} PoolRep;
+
+typedef struct {
+   uint64_t id, gen;   // id 0 = unused
+   void    *free;
+   int      n;
+} Cache;
+
+static _Thread_local Cache cache[CACHE_SLOTS];
+
+static pthread_mutex_t liveLock = PTHREAD_MUTEX_INITIALIZER;
+static pool            live = NULL;
+static uint64_t        lastId = 0;
+
+#define NEXT(obj) (*(void **)(obj))
+
+pool newPool(size_t objSize) {
+   assert(objSize > 0);
+   pool p = malloc(sizeof(PoolRep));
+   assert(p != NULL);
+   // a multiple of the pointer size; objects then sit at multiples of objSize
+   // from a max_align_t boundary, which suits any type whose size is objSize
+   p->objSize = (objSize + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+   p->perSlab = SLAB_BYTES / p->objSize;
+   if (p->perSlab < MIN_PER_SLAB)
+      p->perSlab = MIN_PER_SLAB;
+   p->gen = 0;
+   p->free = NULL;
+   p->first = p->last = p->cur = NULL;
+   p->used = 0;
+   pthread_mutex_init(&p->lock, NULL);
+   pthread_mutex_lock(&liveLock);
+   p->id = ++lastId;
+   p->nextLive = live;
+   live = p;
+   pthread_mutex_unlock(&liveLock);
+   return p;
+}
+
+void dropPool(pool p) {
+   pthread_mutex_lock(&liveLock);
+   pool *q = &live;
+   while (*q != p)
+      q = &(*q)->nextLive;
+   *q = p->nextLive;
+   pthread_mutex_unlock(&liveLock);
+
+   Slab *s = p->first;
+   while (s != NULL) {
+      Slab *next = s->next;
+      free(s);
+      s = next;
+   }
+   pthread_mutex_destroy(&p->lock);
+   free(p);
+}
+
+size_t poolObjectSize(pool p) {
+   return p->objSize;
+}
+
+void poolReset(pool p) {
+   pthread_mutex_lock(&p->lock);
+   p->gen++;           // every thread's cached list for p is now stale
+   p->free = NULL;
+   p->cur = p->first;
+   p->used = 0;
+   pthread_mutex_unlock(&p->lock);
+}
+
+// with p->lock held: link up to n free objects into a list, returns how many
+static int takeObjects(pool p, int n, void **list) {
+   int k = 0;
+   while (k < n && p->free != NULL) {
+      void *obj = p->free;
+      p->free = NEXT(obj);
+      NEXT(obj) = *list;
+      *list = obj;
+      k++;
+   }
+   while (k < n) {
+      if (p->cur == NULL || p->used == p->perSlab) {
+         if (p->cur != NULL && p->cur->next != NULL) {   // reuse a slab kept by a reset
+            p->cur = p->cur->next;
+         } else {
+            Slab *s = malloc(sizeof(Slab) + p->perSlab * p->objSize);
+            assert(s != NULL);
+            s->next = NULL;
+            if (p->last != NULL)
+               p->last->next = s;
+            else
+               p->first = s;
+            p->last = p->cur = s;
+         }
+         p->used = 0;
+      }
+      void *obj = (char *)p->cur->obj + p->used++ * p->objSize;
+      NEXT(obj) = *list;
+      *list = obj;
+      k++;
+   }
+   return k;
+}
+
+// with p->lock held: hand the first n objects of *list back to p
+static void giveObjects(pool p, int n, void **list) {
+   while (n-- > 0) {
+      void *obj = *list;
+      *list = NEXT(obj);
+      NEXT(obj) = p->free;
+      p->free = obj;
+   }
+}
+
+// make c the current thread's list for p; objects still cached for another
+// live pool go back to it, those of a dropped pool or an older generation are stale
+static void switchCache(Cache *c, pool p) {
+   if (c->id != 0 && c->n > 0 && c->id != p->id) {
+      pthread_mutex_lock(&liveLock);
+      pool q = live;
+      while (q != NULL && q->id != c->id)
+         q = q->nextLive;
+      if (q != NULL) {
+         pthread_mutex_lock(&q->lock);
+         if (q->gen == c->gen)
+            giveObjects(q, c->n, &c->free);
+         pthread_mutex_unlock(&q->lock);
+      }
+      pthread_mutex_unlock(&liveLock);
+   }
+   c->id = p->id;
+   c->gen = p->gen;
+   c->free = NULL;
+   c->n = 0;
+}
+
+void *poolAlloc(pool p) {
+   Cache *c = &cache[p->id % CACHE_SLOTS];
+   if (c->id != p->id || c->gen != p->gen)
+      switchCache(c, p);
+   if (c->free == NULL) {
+      pthread_mutex_lock(&p->lock);
+      c->n = takeObjects(p, BATCH, &c->free);
+      pthread_mutex_unlock(&p->lock);
+   }
+   void *obj = c->free;
+   c->free = NEXT(obj);
+   c->n--;
+   return obj;
+}
+
+void poolFree(pool p, void *obj) {
+   if (obj == NULL)
+      return;
+   Cache *c = &cache[p->id % CACHE_SLOTS];
+   if (c->id != p->id || c->gen != p->gen)
+      switchCache(c, p);
+   NEXT(obj) = c->free;
+   c->free = obj;
+   if (++c->n >= 2 * BATCH) {   // keep at most 2*BATCH per thread
+      pthread_mutex_lock(&p->lock);
+      giveObjects(p, BATCH, &c->free);
+      pthread_mutex_unlock(&p->lock);
+      c->n -= BATCH;
+   }
+}
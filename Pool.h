@@ -0,0 +1,20 @@
+// Pool allocator for fixed-size objects ... COMP9024 25T1
+// objects are carved out of large slabs; each thread keeps its own free list
+// per pool and only takes the pool's lock to move a batch of objects at a time
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+typedef struct PoolRep *pool;
+
+pool  newPool(size_t objSize);   // pool of objects of objSize bytes (e.g. sizeof(Node))
+void  dropPool(pool);            // free the pool and every object in it, O(#slabs)
+void *poolAlloc(pool);           // new object (uninitialised)
+void  poolFree(pool, void *);    // give back an object allocated from this pool
+size_t poolObjectSize(pool);     // #bytes per object (objSize rounded up to a multiple of sizeof(void *))
+// free every object of the pool at once, O(1); the slabs are kept and reused
+// dropPool and poolReset must not run while other threads use the pool
+void  poolReset(pool);
+
+#endif
@@ -1,37 +1,44 @@
 // Queue ADT implementation ... COMP9024 25T1
+// ring buffer: the queue is item[head], item[head+1], ... (indices mod size),
+// size a power of 2 that doubles when the buffer is full
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "Queue.h"
 
-typedef struct node {
-   int data;
-   struct node *next;
-} NodeT;
-
 typedef struct QueueRep {
    int   length;
-   NodeT *head;
-   NodeT *tail;
+   int   head;    // index of the front item
+   int   size;    // allocated length of item[], a power of 2
+   int  *item;
 } QueueRep;
 
+#define MIN_SIZE 16
+
 // set up empty queue
 queue newQueue() {
+   return newQueueReserve(MIN_SIZE);
+}
+
+// set up empty queue that takes n ints before it has to grow
+queue newQueueReserve(int n) {
+   assert(n >= 0);
    queue Q = malloc(sizeof(QueueRep));
+   assert(Q != NULL);
+   Q->size = MIN_SIZE;
+   while (Q->size < n)
+      Q->size *= 2;
+   Q->item = malloc(Q->size * sizeof(int));
+   assert(Q->item != NULL);
    Q->length = 0;
-   Q->head = NULL;
-   Q->tail = NULL;
+   Q->head = 0;
    return Q;
 }
 
 // remove unwanted queue
 void dropQueue(queue Q) {
-   NodeT *curr = Q->head;
-   while (curr != NULL) {
-      NodeT *temp = curr->next;
-      free(curr);
-      curr = temp;
-   }
+   free(Q->item);
    free(Q);
 }
 
@@ -40,32 +47,61 @@ int QueueIsEmpty(queue Q) {
    return (Q->length == 0);
 }
 
+// make room for at least n ints; the wrapped-around part moves behind the rest
+static void reserve(queue Q, int n) {
+   if (n <= Q->size)
+      return;
+   int size = Q->size, first = Q->size - Q->head;
+   while (size < n)
+      size *= 2;
+   Q->item = realloc(Q->item, size * sizeof(int));
+   assert(Q->item != NULL);
+   if (Q->length > first)   // items at 0.. follow the ones at head..oldSize-1
+      memcpy(Q->item + Q->size, Q->item, (Q->length - first) * sizeof(int));
+   Q->size = size;
+}
+
 // insert an int at end of queue
 void QueueEnqueue(queue Q, int v) {
-   NodeT *new = malloc(sizeof(NodeT));
-   assert(new != NULL);
-   new->data = v;
-   new->next = NULL;
-   if (Q->tail != NULL) {
-      Q->tail->next = new;
-      Q->tail = new;
-   } else {
-      Q->head = new;
-      Q->tail = new;
-   }
+   if (Q->length == Q->size)
+      reserve(Q, Q->length + 1);
+   Q->item[(Q->head + Q->length) & (Q->size - 1)] = v;
    Q->length++;
 }
 
 // remove int from front of queue
 int QueueDequeue(queue Q) {
    assert(Q->length > 0);
-   NodeT *p = Q->head;
-   Q->head = Q->head->next;
-   if (Q->head == NULL) {
-      Q->tail = NULL;
-   }
+   int d = Q->item[Q->head];
+   Q->head = (Q->head + 1) & (Q->size - 1);
    Q->length--;
-   int d = p->data;
-   free(p);
    return d;
-}
\ No newline at end of file
+}
+
+// insert v[0..n-1] at end of queue, at most two block copies
+void QueueEnqueueN(queue Q, const int v[], int n) {
+   assert(n >= 0 && (n == 0 || v != NULL));
+   if (n == 0)
+      return;
+   reserve(Q, Q->length + n);
+   int tail = (Q->head + Q->length) & (Q->size - 1);
+   int first = (n < Q->size - tail) ? n : Q->size - tail;
+   memcpy(Q->item + tail, v, first * sizeof(int));
+   memcpy(Q->item, v + first, (n - first) * sizeof(int));
+   Q->length += n;
+}
+
+// remove up to n ints from front of queue into v[], returns how many
+int QueueDequeueN(queue Q, int v[], int n) {
+   assert(n >= 0 && (n == 0 || v != NULL));
+   if (n > Q->length)
+      n = Q->length;
+   if (n == 0)
+      return 0;
+   int first = (n < Q->size - Q->head) ? n : Q->size - Q->head;
+   memcpy(v, Q->item + Q->head, first * sizeof(int));
+   memcpy(v + first, Q->item, (n - first) * sizeof(int));
+   Q->head = (Q->head + n) & (Q->size - 1);
+   Q->length -= n;
+   return n;
+}
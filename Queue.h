@@ -3,7 +3,11 @@
 typedef struct QueueRep *queue;
 
 queue newQueue();               // set up empty queue
+queue newQueueReserve(int n);   // set up empty queue with room for n ints
 void  dropQueue(queue);         // remove unwanted queue
 int   QueueIsEmpty(queue);      // check whether queue is empty
 void  QueueEnqueue(queue, int); // insert an int at end of queue
-int   QueueDequeue(queue);      // remove int from front of queue
\ No newline at end of file
+int   QueueDequeue(queue);      // remove int from front of queue
+void  QueueEnqueueN(queue, const int v[], int n);  // insert v[0..n-1] at end of queue
+int   QueueDequeueN(queue, int v[], int n);        // remove up to n ints from front of queue
+                                                   // into v[], returns how many
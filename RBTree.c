@@ -9,19 +9,12 @@
 #define PRINT_COLOUR_RED   "\x1B[31m"
 #define PRINT_COLOUR_RESET "\x1B[0m"
 
-#define data(tree)   ((tree)->data)
-#define left(tree)   ((tree)->left)
-#define right(tree)  ((tree)->right)
-#define colour(tree) ((tree)->colour)
-#define isRed(tree)  ((tree) != NULL && (tree)->colour == RED)
+static pool nodePool = NULL;   // NULL: nodes are malloc'd
 
-typedef enum {RED,BLACK} Colr;
-
-typedef struct Node {
-   int  data;
-   Colr colour;
-   Tree left, right;
-} Node;
+void useTreePool(pool p) {
+   assert(p == NULL || poolObjectSize(p) >= sizeof(Node));
+   nodePool = p;
+}
 
 // create a new empty Tree
 Tree newTree() {
@@ -30,7 +23,7 @@ Tree newTree() {
 
 // make a new node containing data
 Tree newNode(Item it) {
-   Tree new = malloc(sizeof(Node));
+   Tree new = (nodePool != NULL) ? poolAlloc(nodePool) : malloc(sizeof(Node));
    assert(new != NULL);
    data(new) = it;
    colour(new) = RED;
@@ -131,7 +124,10 @@ void freeTree(Tree t) {
    if (t != NULL) {
       freeTree(left(t));
       freeTree(right(t));
-      free(t);
+      if (nodePool != NULL)
+         poolFree(nodePool, t);
+      else
+         free(t);
    }
 }
 
@@ -1,6 +1,7 @@
 // Red-Black Tree ADT interface ... COMP9024 25T1
 
 #include <stdbool.h>
+#include "Pool.h"
 
 typedef int Item;      // item is just a key
 
@@ -28,4 +29,9 @@ void freeTree(Tree);   // free memory associated with Tree
 void showTree(Tree);   // display a Tree (sideways)
 
 bool TreeSearch(Tree, Item);   // check whether an item is in a Tree
-Tree TreeInsert(Tree, Item);   // insert a new item into a Tree
\ No newline at end of file
+Tree TreeInsert(Tree, Item);   // insert a new item into a Tree
+
+// nodes come from p instead of malloc (NULL: back to malloc); only switch while
+// no tree exists; poolReset(p) then frees every tree at once, without freeTree
+// p = newPool(sizeof(Node))
+void useTreePool(pool p);
\ No newline at end of file
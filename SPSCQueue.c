@@ -0,0 +1,86 @@
+// Single-Producer/Single-Consumer Queue ADT implementation ... COMP9024 25T1
+// head is written only by the consumer and tail only by the producer, each on
+// its own cache line; each side also keeps a private copy of the other side's
+// index and rereads the shared one only when the copy says full/empty
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <sched.h>
+#include "SPSCQueue.h"
+
+#define CACHE_LINE 64
+#define SPIN       64   // failed attempts before a waiting thread starts yielding
+
+typedef struct SPSCQueueRep {
+   void   **item;
+   uint64_t mask;                       // size - 1
+   // consumer's line
+   _Alignas(CACHE_LINE) uint64_t head;  // next item to dequeue
+   uint64_t tailCache;                  // consumer's copy of tail
+   // producer's line
+   _Alignas(CACHE_LINE) uint64_t tail;  // next free slot
+   uint64_t headCache;                  // producer's copy of head
+} SPSCQueueRep;
+
+spscQueue newSPSCQueue(int capacity) {
+   assert(capacity > 0);
+   spscQueue Q = aligned_alloc(CACHE_LINE, sizeof(SPSCQueueRep));
+   assert(Q != NULL);
+   uint64_t size = 1;
+   while (size < (uint64_t)capacity)
+      size *= 2;
+   Q->item = malloc(size * sizeof(void *));
+   assert(Q->item != NULL);
+   Q->mask = size - 1;
+   Q->head = Q->tailCache = 0;
+   Q->tail = Q->headCache = 0;
+   return Q;
+}
+
+void dropSPSCQueue(spscQueue Q) {
+   free(Q->item);
+   free(Q);
+}
+
+// producer only
+bool SPSCTryEnqueue(spscQueue Q, void *item) {
+   uint64_t tail = Q->tail;   // only this thread writes tail
+   if (tail - Q->headCache > Q->mask) {
+      Q->headCache = __atomic_load_n(&Q->head, __ATOMIC_ACQUIRE);
+      if (tail - Q->headCache > Q->mask)
+         return false;        // full
+   }
+   Q->item[tail & Q->mask] = item;
+   __atomic_store_n(&Q->tail, tail + 1, __ATOMIC_RELEASE);   // publishes the item
+   return true;
+}
+
+// consumer only
+bool SPSCTryDequeue(spscQueue Q, void **item) {
+   uint64_t head = Q->head;   // only this thread writes head
+   if (head == Q->tailCache) {
+      Q->tailCache = __atomic_load_n(&Q->tail, __ATOMIC_ACQUIRE);
+      if (head == Q->tailCache)
+         return false;        // empty
+   }
+   *item = Q->item[head & Q->mask];
+   __atomic_store_n(&Q->head, head + 1, __ATOMIC_RELEASE);   // hands the slot back
+   return true;
+}
+
+void SPSCEnqueue(spscQueue Q, void *item) {
+   int tries = 0;
+   while (!SPSCTryEnqueue(Q, item))
+      if (++tries > SPIN)
+         sched_yield();
+}
+
+void *SPSCDequeue(spscQueue Q) {
+   void *item;
+   int tries = 0;
+   while (!SPSCTryDequeue(Q, &item))
+      if (++tries > SPIN)
+         sched_yield();
+   return item;
+}
@@ -0,0 +1,13 @@
+// Single-Producer/Single-Consumer Queue ADT header file ... COMP9024 25T1
+// bounded lock-free ring of pointers between exactly two threads:
+// one only enqueues, the other only dequeues
+#include <stdbool.h>
+
+typedef struct SPSCQueueRep *spscQueue;
+
+spscQueue newSPSCQueue(int capacity);            // empty queue for capacity items (rounded up to a power of 2)
+void      dropSPSCQueue(spscQueue);              // remove unwanted queue
+bool      SPSCTryEnqueue(spscQueue, void *item); // insert at end, false if the queue is full
+bool      SPSCTryDequeue(spscQueue, void **item);// remove from front into *item, false if empty
+void      SPSCEnqueue(spscQueue, void *item);    // insert at end, waiting while the queue is full
+void     *SPSCDequeue(spscQueue);                // remove from front, waiting while the queue is empty
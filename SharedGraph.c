@@ -0,0 +1,164 @@
+// Shared WGraph for concurrent readers (RCU style) ... COMP9024 25T1
+// epoch-based reclamation: a reader records the global epoch in its slot before
+// loading the current version; a version replaced when the epoch became R can
+// only be held by readers whose slot shows an epoch below R, so it is freed as
+// soon as every busy slot shows R or more
+
+#include "SharedGraph.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define IDLE 0   // slot of a reader outside readBegin/readEnd
+
+// one cache line per reader, so readers do not slow each other down
+typedef struct {
+   uint64_t epoch;
+   char     pad[64 - sizeof(uint64_t)];
+} ReaderSlot;
+
+// a replaced version waiting to be freed
+typedef struct Retired {
+   Graph           g;
+   uint64_t        epoch;   // global epoch right after it was replaced
+   struct Retired *next;
+} Retired;
+
+typedef struct {
+   bool insert;
+   Edge e;
+} Update;
+
+typedef struct SharedGraphRep {
+   Graph       current;   // version new readers get
+   uint64_t    epoch;     // global epoch, starts at 1
+   ReaderSlot *slot;
+   int         nReaders;
+   pthread_mutex_t lock;  // held by writers: queue, retired list
+   Update     *queue;
+   int         nQueued, queueCap;
+   Retired    *retired;
+} SharedGraphRep;
+
+SharedGraph newSharedGraph(Graph g, int maxReaders) {
+   assert(g != NULL && maxReaders > 0);
+   SharedGraph s = malloc(sizeof(SharedGraphRep));
+   assert(s != NULL);
+   s->slot = calloc(maxReaders, sizeof(ReaderSlot));   // all IDLE
+   assert(s->slot != NULL);
+   s->current = g;
+   s->epoch = 1;
+   s->nReaders = maxReaders;
+   pthread_mutex_init(&s->lock, NULL);
+   s->queue = NULL;
+   s->nQueued = s->queueCap = 0;
+   s->retired = NULL;
+   return s;
+}
+
+void freeSharedGraph(SharedGraph s) {
+   assert(s != NULL);
+   while (s->retired != NULL) {
+      Retired *r = s->retired;
+      s->retired = r->next;
+      freeGraph(r->g);
+      free(r);
+   }
+   freeGraph(s->current);
+   pthread_mutex_destroy(&s->lock);
+   free(s->queue);
+   free(s->slot);
+   free(s);
+}
+
+// the epoch is published before the version is loaded (both sequentially
+// consistent), which is what makes the reclamation rule above safe
+Graph readBegin(SharedGraph s, int reader) {
+   assert(s != NULL && reader >= 0 && reader < s->nReaders);
+   assert(s->slot[reader].epoch == IDLE);
+   uint64_t e = __atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST);
+   __atomic_store_n(&s->slot[reader].epoch, e, __ATOMIC_SEQ_CST);
+   return __atomic_load_n(&s->current, __ATOMIC_SEQ_CST);
+}
+
+void readEnd(SharedGraph s, int reader) {
+   assert(s != NULL && reader >= 0 && reader < s->nReaders);
+   __atomic_store_n(&s->slot[reader].epoch, IDLE, __ATOMIC_RELEASE);
+}
+
+static void enqueue(SharedGraph s, bool insert, Edge e) {
+   assert(s != NULL);
+   pthread_mutex_lock(&s->lock);
+   if (s->nQueued == s->queueCap) {
+      s->queueCap = (s->queueCap == 0) ? 64 : 2 * s->queueCap;
+      s->queue = realloc(s->queue, s->queueCap * sizeof(Update));
+      assert(s->queue != NULL);
+   }
+   s->queue[s->nQueued].insert = insert;
+   s->queue[s->nQueued].e = e;
+   s->nQueued++;
+   pthread_mutex_unlock(&s->lock);
+}
+
+void sharedInsertEdge(SharedGraph s, Edge e) {
+   enqueue(s, true, e);
+}
+
+void sharedRemoveEdge(SharedGraph s, Edge e) {
+   enqueue(s, false, e);
+}
+
+// smallest epoch shown by a busy reader, or UINT64_MAX if all are idle
+static uint64_t oldestReader(SharedGraph s) {
+   uint64_t oldest = UINT64_MAX;
+   int i;
+   for (i = 0; i < s->nReaders; i++) {
+      uint64_t e = __atomic_load_n(&s->slot[i].epoch, __ATOMIC_SEQ_CST);
+      if (e != IDLE && e < oldest)
+         oldest = e;
+   }
+   return oldest;
+}
+
+// free the retired versions no reader can still hold
+static void reclaim(SharedGraph s) {
+   uint64_t oldest = oldestReader(s);
+   Retired **p = &s->retired;
+   while (*p != NULL) {
+      Retired *r = *p;
+      if (r->epoch <= oldest) {
+         *p = r->next;
+         freeGraph(r->g);
+         free(r);
+      } else {
+         p = &r->next;
+      }
+   }
+}
+
+void publish(SharedGraph s) {
+   assert(s != NULL);
+   int i;
+   pthread_mutex_lock(&s->lock);
+   if (s->nQueued > 0) {
+      Graph old = s->current, g = copyGraph(old);   // readers may be using old
+      for (i = 0; i < s->nQueued; i++) {
+         if (s->queue[i].insert)
+            insertEdge(g, s->queue[i].e);
+         else
+            removeEdge(g, s->queue[i].e);
+      }
+      s->nQueued = 0;
+
+      __atomic_store_n(&s->current, g, __ATOMIC_SEQ_CST);
+      Retired *r = malloc(sizeof(Retired));
+      assert(r != NULL);
+      r->g = old;
+      r->epoch = __atomic_add_fetch(&s->epoch, 1, __ATOMIC_SEQ_CST);
+      r->next = s->retired;
+      s->retired = r;
+   }
+   reclaim(s);
+   pthread_mutex_unlock(&s->lock);
+}
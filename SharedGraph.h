@@ -0,0 +1,24 @@
+// Shared WGraph for concurrent readers (RCU style) ... COMP9024 25T1
+// readers work on an immutable version of the graph and never block;
+// a writer queues edge updates, applies them to a copy and publishes the copy
+// atomically; a version is freed once no reader that may hold it is left
+#include "WGraph.h"
+
+typedef struct SharedGraphRep *SharedGraph;
+
+// take ownership of g as the first version; at most maxReaders threads read at once,
+// each using its own reader slot 0..maxReaders-1
+SharedGraph newSharedGraph(Graph g, int maxReaders);
+void        freeSharedGraph(SharedGraph);   // frees every version; no reads may be in progress
+
+// readers: readBegin returns the current version, which stays valid and unchanged
+// until readEnd with the same slot; it must not be modified or freed
+Graph readBegin(SharedGraph s, int reader);
+void  readEnd(SharedGraph s, int reader);
+
+// writers (any number, they take turns): changes are queued and become
+// visible together at the next publish; to change a weight queue a
+// removal followed by an insertion
+void sharedInsertEdge(SharedGraph s, Edge e);
+void sharedRemoveEdge(SharedGraph s, Edge e);
+void publish(SharedGraph s);   // copy, apply the queue, swap in, reclaim old versions
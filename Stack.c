@@ -1,36 +1,40 @@
 // Stack ADT implementation ... COMP9024 25T1
+// growable array: the stack is item[0..height-1] with the top at item[height-1],
+// size doubles when the array is full
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
-#include "stack.h"
-
-typedef struct node {
-    int data;
-    struct node *next;
-} NodeT;
+#include "Stack.h"
 
 typedef struct StackRep {
-    int    height;   // #elements on stack
-    NodeT *top;      // ptr to first element
+    int  height;   // #elements on stack
+    int  size;     // allocated length of item[]
+    int *item;
 } StackRep;
 
+#define MIN_SIZE 16
+
 // set up empty stack
 stack newStack() {
+    return newStackReserve(MIN_SIZE);
+}
+
+// set up empty stack that takes n ints before it has to grow
+stack newStackReserve(int n) {
+    assert(n >= 0);
     stack S = malloc(sizeof(StackRep));
     assert(S != NULL);
+    S->size = (n > MIN_SIZE) ? n : MIN_SIZE;
+    S->item = malloc(S->size * sizeof(int));
+    assert(S->item != NULL);
     S->height = 0;
-    S->top = NULL;
     return S;
 }
 
 // remove unwanted stack
 void dropStack(stack S) {
-    NodeT *curr = S->top;
-    while (curr != NULL) {
-        NodeT *temp = curr->next;
-        free(curr);
-        curr = temp;
-    }
+    free(S->item);
     free(S);
 }
 
@@ -39,23 +43,55 @@ bool StackIsEmpty(stack S) {
     return (S->height == 0);
 }
 
+// make room for at least n ints
+static void reserve(stack S, int n) {
+    if (n <= S->size)
+        return;
+    int size = S->size;
+    while (size < n)
+        size *= 2;
+    S->item = realloc(S->item, size * sizeof(int));
+    assert(S->item != NULL);
+    S->size = size;
+}
+
 // insert an int on top of stack
 void StackPush(stack S, int v) {
-    NodeT *new = malloc(sizeof(NodeT));
-    assert(new != NULL);
-    new->data = v;
-    new->next = S->top;
-    S->top = new;
-    S->height++;
+    if (S->height == S->size)
+        reserve(S, S->height + 1);
+    S->item[S->height++] = v;
 }
 
 // remove int from top of stack
 int StackPop(stack S) {
     assert(S->height > 0);
-    NodeT *head = S->top;
-    S->top = S->top->next;
-    S->height--;
-    int d = head->data;
-    free(head);
-    return d;
-}
\ No newline at end of file
+    return S->item[--S->height];
+}
+
+// top int, left on the stack
+int StackPeek(stack S) {
+    assert(S->height > 0);
+    return S->item[S->height - 1];
+}
+
+// push v[0..n-1] in order with one block copy
+void StackPushN(stack S, const int v[], int n) {
+    assert(n >= 0 && (n == 0 || v != NULL));
+    if (n == 0)
+        return;
+    reserve(S, S->height + n);
+    memcpy(S->item + S->height, v, n * sizeof(int));
+    S->height += n;
+}
+
+// pop up to n ints into v[] (top first), returns how many
+int StackPopN(stack S, int v[], int n) {
+    assert(n >= 0 && (n == 0 || v != NULL));
+    if (n > S->height)
+        n = S->height;
+    int i;
+    for (i = 0; i < n; i++)
+        v[i] = S->item[S->height - 1 - i];
+    S->height -= n;
+    return n;
+}
@@ -4,7 +4,12 @@
 typedef struct StackRep *stack;
 
 stack newStack();             // set up empty stack
+stack newStackReserve(int n); // set up empty stack with room for n ints
 void  dropStack(stack);       // remove unwanted stack
 bool  StackIsEmpty(stack);    // check whether stack is empty
 void  StackPush(stack, int);  // insert an int on top of stack
-int   StackPop(stack);        // remove int from top of stack
\ No newline at end of file
+int   StackPop(stack);        // remove int from top of stack
+int   StackPeek(stack);       // top int, left on the stack
+void  StackPushN(stack, const int v[], int n);  // push v[0], v[1], ..., v[n-1] (v[n-1] ends on top)
+int   StackPopN(stack, int v[], int n);         // pop up to n ints into v[0], v[1], ... (v[0] = old top),
+                                                // returns how many
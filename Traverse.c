@@ -0,0 +1,125 @@
+// Parallel graph traversal on the Graph ADT ... COMP9024 25T1
+// a vertex is claimed by the first worker to flip its visited flag and goes on
+// that worker's deque, so it is expanded once; pending counts vertices that are
+// on a deque or being expanded, and the traversal is over when it reaches 0
+
+#include "Traverse.h"
+#include "WSDeque.h"
+#include "Parallel.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+
+#define CACHE_LINE 64
+#define SPIN       64   // failed steal rounds before an idle worker starts yielding
+
+typedef struct {
+   Graph    g;
+   bool    *visited;
+   void   (*visit)(Vertex, int, void *);
+   void    *arg;
+   int      T;          // #workers
+   wsDeque *deque;      // deque[t] is owned by worker t
+   int     *count;      // count[t * PAD] = #vertices visited by worker t
+   _Alignas(CACHE_LINE) int64_t pending;
+} TraverseArgs;
+
+#define PAD ((int)(CACHE_LINE / sizeof(int)))
+
+// true if v was not visited before
+static inline bool claim(bool visited[], Vertex v) {
+   return !__atomic_load_n(&visited[v], __ATOMIC_RELAXED)
+       && !__atomic_exchange_n(&visited[v], true, __ATOMIC_RELAXED);
+}
+
+// try every other worker once, starting at a random one
+static bool steal(TraverseArgs *a, int worker, uint32_t *seed, Vertex *v) {
+   *seed ^= *seed << 13;
+   *seed ^= *seed >> 17;
+   *seed ^= *seed << 5;
+   int i, start = (int)(*seed % (uint32_t)a->T);
+   for (i = 0; i < a->T; i++) {
+      int victim = (start + i) % a->T;
+      if (victim == worker)
+         continue;
+      int r;
+      while ((r = WSDequeSteal(a->deque[victim], v)) == WS_ABORT)
+         ;
+      if (r == WS_STOLEN)
+         return true;
+   }
+   return false;
+}
+
+static void traverseWorker(int lo, int hi, int worker, void *arg) {
+   TraverseArgs *a = arg;
+   wsDeque mine = a->deque[worker];
+   uint32_t seed = 2654435761u * (worker + 1);
+   int count = 0, idle = 0;
+   Vertex v, w;
+   for (;;) {
+      if (WSDequePop(mine, &v) || steal(a, worker, &seed, &v)) {
+         idle = 0;
+         count++;
+         if (a->visit != NULL)
+            a->visit(v, worker, a->arg);
+         NeighbourIter it;
+         for (neighbours(a->g, v, &it); nextNeighbour(&it, &w); ) {
+            if (claim(a->visited, w)) {
+               __atomic_add_fetch(&a->pending, 1, __ATOMIC_RELAXED);
+               WSDequePush(mine, w);
+            }
+         }
+         // w's increment happens before v's decrement, so pending cannot hit 0 early
+         __atomic_sub_fetch(&a->pending, 1, __ATOMIC_ACQ_REL);
+      } else if (__atomic_load_n(&a->pending, __ATOMIC_ACQUIRE) == 0) {
+         break;
+      } else if (++idle > SPIN) {
+         sched_yield();
+      }
+   }
+   a->count[worker * PAD] = count;
+   (void)lo;
+   (void)hi;
+}
+
+int parallelTraverse(Graph g, const Vertex src[], int nSrc, bool visited[],
+                     void (*visit)(Vertex v, int worker, void *arg), void *arg) {
+   assert(g != NULL && visited != NULL && nSrc >= 0 && (nSrc == 0 || src != NULL));
+   int T = numWorkers(), t, i, total = 0;
+   TraverseArgs *a = aligned_alloc(CACHE_LINE, sizeof(TraverseArgs));
+   assert(a != NULL);
+   a->g = g;
+   a->visited = visited;
+   a->visit = visit;
+   a->arg = arg;
+   a->T = T;
+   a->pending = 0;
+   a->deque = malloc(T * sizeof(wsDeque));
+   a->count = malloc((size_t)T * PAD * sizeof(int));
+   assert(a->deque != NULL && a->count != NULL);
+   for (t = 0; t < T; t++)
+      a->deque[t] = newWSDeque(0);
+
+   // sources are dealt out round-robin before any worker starts
+   for (i = 0; i < nSrc; i++) {
+      assert(src[i] >= 0 && src[i] < numOfVertices(g));
+      if (claim(visited, src[i])) {
+         WSDequePush(a->deque[a->pending % T], src[i]);
+         a->pending++;
+      }
+   }
+
+   // one chunk per worker, so worker t owns deque[t]
+   parallelForWorkers(T, T, traverseWorker, a);
+
+   for (t = 0; t < T; t++) {
+      total += a->count[t * PAD];
+      dropWSDeque(a->deque[t]);
+   }
+   free(a->deque);
+   free(a->count);
+   free(a);
+   return total;
+}
@@ -0,0 +1,16 @@
+// Parallel graph traversal on the Graph ADT ... COMP9024 25T1
+// depth-first-style exploration by all workers of Parallel.h: each worker
+// pops the vertex it discovered most recently from its own work-stealing
+// deque (WSDeque.h) and, when that runs dry, steals the oldest vertex of another
+// worker; the order in which vertices are visited is therefore not a DFS order
+#include "Graph.h"
+
+// visits every vertex reachable from src[0..nSrc-1] exactly once:
+// visited[v] is set, then visit(v, worker, arg) is called (unless visit is NULL)
+// by the worker (0..numWorkers()-1) that claimed v
+// vertices already marked in visited[] are neither visited nor entered, so
+// clearing visited[] first gives plain reachability, and repeated calls from
+// unmarked vertices discover components one at a time
+// returns the number of vertices visited
+int parallelTraverse(Graph g, const Vertex src[], int nSrc, bool visited[],
+                     void (*visit)(Vertex v, int worker, void *arg), void *arg);
@@ -0,0 +1,206 @@
+// Unrolled linked list implementation ... COMP9024 25T1
+// ints are appended to the head block until it is full, and a deleted int is
+// replaced by the last int of the head block, so every block but the head is
+// full and a scan touches about n/UL_BLOCK nodes
+// the hash set uses linear probing with backward-shift deletion (no tombstones)
+
+#include "UList.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct Block {
+   struct Block *next;   // next block (older ints)
+   int           n;      // #ints in v[]
+   int           v[UL_BLOCK];
+} Block;
+
+typedef struct UListRep {
+   Block    *head;       // the only block that may be partly filled
+   int       size;
+   // side hash set, unused if slot == NULL
+   int      *slot;
+   bool     *used;
+   uint32_t  mask;       // #slots - 1
+   int       shift;      // 32 - log2(#slots)
+} UListRep;
+
+#define MIN_SLOTS 16
+
+UList newUList() {
+   UList L = malloc(sizeof(UListRep));
+   assert(L != NULL);
+   L->head = NULL;
+   L->size = 0;
+   L->slot = NULL;
+   L->used = NULL;
+   L->mask = 0;
+   L->shift = 0;
+   return L;
+}
+
+static void allocSlots(UList L, uint32_t nSlots) {
+   L->slot = malloc(nSlots * sizeof(int));
+   L->used = calloc(nSlots, sizeof(bool));
+   assert(L->slot != NULL && L->used != NULL);
+   L->mask = nSlots - 1;
+   L->shift = 32;
+   while (nSlots > 1) {
+      nSlots /= 2;
+      L->shift--;
+   }
+}
+
+UList newUListHashed() {
+   UList L = newUList();
+   allocSlots(L, MIN_SLOTS);
+   return L;
+}
+
+void freeUList(UList L) {
+   Block *b = L->head;
+   while (b != NULL) {
+      Block *next = b->next;
+      free(b);
+      b = next;
+   }
+   free(L->slot);
+   free(L->used);
+   free(L);
+}
+
+int sizeUL(UList L) {
+   return L->size;
+}
+
+// Fibonacci hashing: the top bits of x * 2^32/phi
+static inline uint32_t home(UList L, int x) {
+   return ((uint32_t)x * 2654435769u) >> L->shift;
+}
+
+// slot holding x, or the empty slot where x would go
+static uint32_t findSlot(UList L, int x) {
+   uint32_t i = home(L, x);
+   while (L->used[i] && L->slot[i] != x)
+      i = (i + 1) & L->mask;
+   return i;
+}
+
+static void hashAdd(UList L, int x) {
+   if (2 * (uint32_t)(L->size + 1) > L->mask + 1) {   // keep the load at most 1/2
+      int      *oldSlot = L->slot;
+      bool     *oldUsed = L->used;
+      uint32_t  i, oldSlots = L->mask + 1;
+      allocSlots(L, 2 * oldSlots);
+      for (i = 0; i < oldSlots; i++) {
+         if (oldUsed[i]) {
+            uint32_t j = findSlot(L, oldSlot[i]);
+            L->slot[j] = oldSlot[i];
+            L->used[j] = true;
+         }
+      }
+      free(oldSlot);
+      free(oldUsed);
+   }
+   uint32_t i = findSlot(L, x);
+   L->slot[i] = x;
+   L->used[i] = true;
+}
+
+static void hashRemove(UList L, int x) {
+   uint32_t i = findSlot(L, x), j = i;
+   assert(L->used[i]);
+   // pull later entries of the probe run back into the hole while they may move
+   for (;;) {
+      j = (j + 1) & L->mask;
+      if (!L->used[j])
+         break;
+      uint32_t h = home(L, L->slot[j]);
+      if (((j - h) & L->mask) >= ((j - i) & L->mask)) {   // h is not inside (i, j]
+         L->slot[i] = L->slot[j];
+         i = j;
+      }
+   }
+   L->used[i] = false;
+}
+
+// index of x in v[0..n-1], or -1; no early exit, so the loop vectorises
+static inline int findInBlock(const int v[], int n, int x) {
+   int i, at = -1;
+   for (i = 0; i < n; i++)
+      if (v[i] == x)
+         at = i;
+   return at;
+}
+
+// block holding x and x's index in *at, or NULL
+static Block *scan(UList L, int x, int *at) {
+   Block *b;
+   for (b = L->head; b != NULL; b = b->next) {
+      *at = findInBlock(b->v, b->n, x);
+      if (*at >= 0)
+         return b;
+   }
+   return NULL;
+}
+
+bool inUL(UList L, int x) {
+   if (L->slot != NULL)
+      return L->used[findSlot(L, x)];
+   int at;
+   return scan(L, x, &at) != NULL;
+}
+
+bool insertUL(UList L, int x) {
+   if (inUL(L, x))
+      return false;
+   if (L->head == NULL || L->head->n == UL_BLOCK) {
+      Block *b = malloc(sizeof(Block));
+      assert(b != NULL);
+      b->n = 0;
+      b->next = L->head;
+      L->head = b;
+   }
+   L->head->v[L->head->n++] = x;
+   if (L->slot != NULL)
+      hashAdd(L, x);
+   L->size++;
+   return true;
+}
+
+bool deleteUL(UList L, int x) {
+   if (L->slot != NULL && !L->used[findSlot(L, x)])
+      return false;
+   int at;
+   Block *b = scan(L, x, &at);
+   if (b == NULL)
+      return false;
+   Block *h = L->head;
+   b->v[at] = h->v[--h->n];   // fill the hole from the head block
+   if (h->n == 0) {
+      L->head = h->next;
+      free(h);
+   }
+   if (L->slot != NULL)
+      hashRemove(L, x);
+   L->size--;
+   return true;
+}
+
+void showUL(UList L) {
+   // blocks are linked newest first, so print them from the tail back
+   int nBlocks = 0, i, k;
+   Block *b;
+   for (b = L->head; b != NULL; b = b->next)
+      nBlocks++;
+   Block **order = malloc((nBlocks + 1) * sizeof(Block *));
+   assert(order != NULL);
+   for (b = L->head, k = 0; b != NULL; b = b->next)
+      order[k++] = b;
+   while (k-- > 0)
+      for (i = 0; i < order[k]->n; i++)
+         printf("%d ", order[k]->v[i]);
+   putchar('\n');
+   free(order);
+}
@@ -0,0 +1,18 @@
+// Unrolled linked list interface ... COMP9024 25T1
+// a set of ints like List.h, but each node holds a block of UL_BLOCK ints that
+// is scanned without branches (the compiler vectorises the loop at -O3);
+// with a side hash set, inUL and the duplicate check of insertUL take O(1)
+#include <stdbool.h>
+
+#define UL_BLOCK 29   // ints per node: 29 ints, a count and a pointer fill 128 bytes
+
+typedef struct UListRep *UList;
+
+UList newUList();         // empty set, membership by scanning the blocks: O(n/UL_BLOCK) nodes
+UList newUListHashed();   // empty set with a side hash set: O(1) expected membership
+void  freeUList(UList);
+bool  insertUL(UList, int);   // add an int, false if it was already there
+bool  deleteUL(UList, int);   // remove an int, false if it was not there
+bool  inUL(UList, int);
+int   sizeUL(UList);          // #ints in the set
+void  showUL(UList);          // ints in the order they are stored (insertion order until a delete)
@@ -0,0 +1,80 @@
+// Concurrent Union-Find (disjoint sets) ADT implementation ... COMP9024 25T1
+// lock-free: roots are linked with a CAS, the larger index always below the smaller,
+// so the representative of a set is its smallest element and no cycle can form;
+// finds shorten paths by halving, also with (best-effort) CAS
+
+#include "UnionFind.h"
+#include <assert.h>
+#include <stdlib.h>
+
+typedef struct UnionFindRep {
+   int *parent;   // parent[x] == x for roots
+   int  n;
+} UnionFindRep;
+
+UnionFind newUnionFind(int n) {
+   assert(n >= 0);
+   UnionFind uf = malloc(sizeof(UnionFindRep));
+   assert(uf != NULL);
+   uf->parent = malloc((n + 1) * sizeof(int));
+   assert(uf->parent != NULL);
+   uf->n = n;
+   int x;
+   for (x = 0; x < n; x++)
+      uf->parent[x] = x;
+   return uf;
+}
+
+void dropUnionFind(UnionFind uf) {
+   assert(uf != NULL);
+   free(uf->parent);
+   free(uf);
+}
+
+static inline int load(UnionFind uf, int x) {
+   return __atomic_load_n(&uf->parent[x], __ATOMIC_ACQUIRE);
+}
+
+int ufFind(UnionFind uf, int x) {
+   assert(uf != NULL && x >= 0 && x < uf->n);
+   int p = load(uf, x);
+   while (p != x) {
+      int gp = load(uf, p);
+      if (gp != p)   // point x at its grandparent; losing the race is harmless
+         __atomic_compare_exchange_n(&uf->parent[x], &p, gp, false,
+                                     __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+      x = gp;        // and go on from there, skipping the parent (halving)
+      p = load(uf, x);
+   }
+   return x;
+}
+
+bool ufUnion(UnionFind uf, int x, int y) {
+   assert(uf != NULL && x >= 0 && x < uf->n && y >= 0 && y < uf->n);
+   for (;;) {
+      x = ufFind(uf, x);
+      y = ufFind(uf, y);
+      if (x == y)
+         return false;
+      if (x < y) {   // link the larger root below the smaller one
+         int t = x; x = y; y = t;
+      }
+      int expected = x;
+      if (__atomic_compare_exchange_n(&uf->parent[x], &expected, y, false,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+         return true;
+      // x stopped being a root meanwhile: retry from the new roots
+   }
+}
+
+bool ufSame(UnionFind uf, int x, int y) {
+   assert(uf != NULL);
+   for (;;) {
+      x = ufFind(uf, x);
+      y = ufFind(uf, y);
+      if (x == y)
+         return true;
+      if (load(uf, x) == x)   // x is still a root, so the sets really differ
+         return false;
+   }
+}
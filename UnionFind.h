@@ -0,0 +1,11 @@
+// Concurrent Union-Find (disjoint sets) ADT interface ... COMP9024 25T1
+// elements are 0..n-1; ufFind and ufUnion may be called from many threads at once
+#include <stdbool.h>
+
+typedef struct UnionFindRep *UnionFind;
+
+UnionFind newUnionFind(int n);               // n singleton sets
+void      dropUnionFind(UnionFind);
+int       ufFind(UnionFind, int x);          // representative of x's set
+bool      ufUnion(UnionFind, int x, int y);  // merge the sets of x and y, false if already one set
+bool      ufSame(UnionFind, int x, int y);   // check if x and y are in the same set
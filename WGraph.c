@@ -1,15 +1,42 @@
 // Weighted Directed Graph ADT
-// Adjacency Matrix Representation ... COMP9024 25T1
+// Adjacency Matrix or Adjacency List Representation ... COMP9024 25T1
 #include "WGraph.h"
+#include "Parallel.h"
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// entry in an adjacency list
+typedef struct Arc {
+   Vertex w;
+   int    weight;
+} Arc;
 
 typedef struct GraphRep {
-   int **edges;  // adjacency matrix storing positive weights
-		 // 0 if nodes not adjacent
-   int nV;       // #vertices
-   int nE;       // #edges
+   bool  sparse;  // adjacency lists instead of adjacency matrix
+   int **edges;   // adjacency matrix storing positive weights
+		  // 0 if nodes not adjacent
+   int  *cells;   // single block holding all rows of the matrix
+   Arc **adj;     // adjacency lists of outgoing edges (sparse graphs only)
+   int  *deg;     // #entries in each adjacency list
+   int  *cap;     // allocated size of each adjacency list
+   Arc  *pool;    // single block holding bulk-built adjacency lists, or NULL
+   size_t poolLen;// #entries in pool
+   void *map;     // file mapping the arrays point into (loadGraph), or NULL
+   size_t mapLen;
+   int nV;        // #vertices
+   int nE;        // #edges
+   int vCap;      // #vertices there is room for; matrix rows are vCap cells apart
+   bool *removed; // removed[v] iff v was removed and awaits reuse, or NULL if none ever was
+   Vertex *freeIds; // stack of removed vertices
+   int nFree, freeCap;
 } GraphRep;
 
 Graph newGraph(int V) {
@@ -18,17 +45,56 @@ Graph newGraph(int V) {
 
    Graph g = malloc(sizeof(GraphRep));
    assert(g != NULL);
+   g->sparse = false;
    g->nV = V;
    g->nE = 0;
+   g->adj = NULL;
+   g->deg = g->cap = NULL;
+   g->pool = NULL;
+   g->poolLen = 0;
+   g->map = NULL;
+   g->mapLen = 0;
+   g->vCap = V;
+   g->removed = NULL;
+   g->freeIds = NULL;
+   g->nFree = g->freeCap = 0;
 
-   // allocate memory for each row
-   g->edges = malloc(V * sizeof(int *));
+   // allocate the whole matrix at once and initialise with 0
+   g->cells = calloc((size_t)V * V + 1, sizeof(int));
+   assert(g->cells != NULL);
+   // row pointers into the matrix
+   g->edges = malloc((V + 1) * sizeof(int *));
    assert(g->edges != NULL);
-   // allocate memory for each column and initialise with 0
-   for (i = 0; i < V; i++) {
-      g->edges[i] = calloc(V, sizeof(int));
-      assert(g->edges[i] != NULL);
-   }
+   for (i = 0; i < V; i++)
+      g->edges[i] = g->cells + (size_t)i * V;
+
+   return g;
+}
+
+Graph newSparseGraph(int V) {
+   assert(V >= 0);
+
+   Graph g = malloc(sizeof(GraphRep));
+   assert(g != NULL);
+   g->sparse = true;
+   g->nV = V;
+   g->nE = 0;
+   g->edges = NULL;
+   g->cells = NULL;
+   g->pool = NULL;
+   g->poolLen = 0;
+   g->map = NULL;
+   g->mapLen = 0;
+   g->vCap = V;
+   g->removed = NULL;
+   g->freeIds = NULL;
+   g->nFree = g->freeCap = 0;
+
+   // empty adjacency lists, grown on demand
+   g->adj = calloc(V, sizeof(Arc *));
+   g->deg = calloc(V, sizeof(int));
+   g->cap = calloc(V, sizeof(int));
+   assert(g->adj != NULL && g->deg != NULL && g->cap != NULL);
 
    return g;
 }
@@ -42,10 +108,45 @@ int validV(Graph g, Vertex v) {
    return (g != NULL && v >= 0 && v < g->nV);
 }
 
+// check if v's adjacency list lives in the shared pool rather than its own block
+static inline bool inPool(Graph g, Vertex v) {
+   return g->pool != NULL && g->adj[v] >= g->pool && g->adj[v] < g->pool + g->poolLen;
+}
+
+// position of w in v's adjacency list, or -1
+static int findArc(Graph g, Vertex v, Vertex w) {
+   int i;
+   for (i = 0; i < g->deg[v]; i++)
+      if (g->adj[v][i].w == w)
+         return i;
+   return -1;
+}
+
 void insertEdge(Graph g, Edge e) {
    assert(g != NULL && validV(g,e.v) && validV(g,e.w));
+   assert(g->map == NULL);   // loaded graphs are read-only
+   assert(g->removed == NULL || (!g->removed[e.v] && !g->removed[e.w]));
 
-   if (g->edges[e.v][e.w] == 0) {   // edge e not in graph
+   if (g->sparse) {
+      if (findArc(g, e.v, e.w) < 0) {   // edge e not in graph
+         if (g->deg[e.v] == g->cap[e.v]) {
+            g->cap[e.v] = (g->cap[e.v] == 0) ? 4 : 2 * g->cap[e.v];
+            if (inPool(g, e.v)) {   // move the list out of the pool into its own block
+               Arc *list = malloc(g->cap[e.v] * sizeof(Arc));
+               assert(list != NULL);
+               memcpy(list, g->adj[e.v], g->deg[e.v] * sizeof(Arc));
+               g->adj[e.v] = list;
+            } else {
+               g->adj[e.v] = realloc(g->adj[e.v], g->cap[e.v] * sizeof(Arc));
+               assert(g->adj[e.v] != NULL);
+            }
+         }
+         g->adj[e.v][g->deg[e.v]].w = e.w;
+         g->adj[e.v][g->deg[e.v]].weight = e.weight;
+         g->deg[e.v]++;
+         g->nE++;
+      }
+   } else if (g->edges[e.v][e.w] == 0) {   // edge e not in graph
       g->edges[e.v][e.w] = e.weight;
       g->nE++;
    }
@@ -53,37 +154,632 @@ void insertEdge(Graph g, Edge e) {
 
 void removeEdge(Graph g, Edge e) {
    assert(g != NULL && validV(g,e.v) && validV(g,e.w));
+   assert(g->map == NULL);   // loaded graphs are read-only
 
-   if (g->edges[e.v][e.w] != 0) {   // edge e in graph
+   if (g->sparse) {
+      int i = findArc(g, e.v, e.w);
+      if (i >= 0) {   // edge e in graph
+         g->adj[e.v][i] = g->adj[e.v][--g->deg[e.v]];
+         g->nE--;
+      }
+   } else if (g->edges[e.v][e.w] != 0) {   // edge e in graph
       g->edges[e.v][e.w] = 0;
       g->nE--;
    }
 }
 
+// O(1) for the matrix, O(outdeg(v)) for adjacency lists
 int adjacent(Graph g, Vertex v, Vertex w) {
    assert(g != NULL && validV(g,v) && validV(g,w));
 
+   if (g->sparse) {
+      int i = findArc(g, v, w);
+      return (i >= 0) ? g->adj[v][i].weight : 0;
+   }
    return g->edges[v][w];
 }
 
+static int compareArc(const void *a, const void *b) {
+   Vertex v = ((const Arc *)a)->w, w = ((const Arc *)b)->w;
+   return (v > w) - (v < w);
+}
+
 void showGraph(Graph g) {
     assert(g != NULL);
     int i, j;
 
     printf("Number of vertices: %d\n", g->nV);
     printf("Number of edges: %d\n", g->nE);
+    if (g->sparse) {
+       // walk each neighbour list, printed in ascending order as for the matrix:
+       // O(V + E log(max degree)) instead of V^2 calls to adjacent
+       int maxDeg = 1;
+       for (i = 0; i < g->nV; i++)
+          if (g->deg[i] > maxDeg)
+             maxDeg = g->deg[i];
+       Arc *sorted = malloc(maxDeg * sizeof(Arc));
+       assert(sorted != NULL);
+       for (i = 0; i < g->nV; i++) {
+          if (g->deg[i] == 0)
+             continue;
+          NeighbourIter it;
+          int n = 0;
+          for (neighbours(g, i, &it); nextNeighbour(&it, &sorted[n].w, &sorted[n].weight); )
+             n++;
+          qsort(sorted, n, sizeof(Arc), compareArc);
+          for (j = 0; j < n; j++)
+             printf("Edge %d - %d: %d\n", i, sorted[j].w, sorted[j].weight);
+       }
+       free(sorted);
+       return;
+    }
     for (i = 0; i < g->nV; i++)
        for (j = 0; j < g->nV; j++)
-	  if (g->edges[i][j] != 0)
-	     printf("Edge %d - %d: %d\n", i, j, g->edges[i][j]);
+	  if (adjacent(g, i, j) != 0)
+	     printf("Edge %d - %d: %d\n", i, j, adjacent(g, i, j));
 }
 
 void freeGraph(Graph g) {
    assert(g != NULL);
 
    int i;
-   for (i = 0; i < g->nV; i++)
-      free(g->edges[i]);
-   free(g->edges);
+   if (g->map != NULL) {   // only the row/list pointers and removed flags live outside the mapping
+      munmap(g->map, g->mapLen);
+      free(g->sparse ? (void *)g->adj : (void *)g->edges);
+      free(g->removed);
+      free(g);
+      return;
+   }
+   if (g->sparse) {
+      for (i = 0; i < g->nV; i++)
+         if (!inPool(g, i))
+            free(g->adj[i]);
+      free(g->pool);
+      free(g->adj);
+      free(g->deg);
+      free(g->cap);
+   } else {
+      free(g->cells);
+      free(g->edges);
+   }
+   free(g->removed);
+   free(g->freeIds);
    free(g);
-}
\ No newline at end of file
+}
+
+// copies every array with one allocation each; adjacency lists of a sparse
+// graph are packed back to back into a single pool
+Graph copyGraph(Graph g) {
+   assert(g != NULL);
+   int v;
+
+   Graph c = malloc(sizeof(GraphRep));
+   assert(c != NULL);
+   *c = *g;
+   c->map = NULL;      // a copy of a loaded graph is an ordinary, writable graph
+   c->mapLen = 0;
+   c->vCap = g->nV;
+   c->removed = NULL;
+   c->freeIds = NULL;
+   c->freeCap = c->nFree;
+   if (g->nFree > 0) {
+      c->removed = malloc(g->nV * sizeof(bool));
+      c->freeIds = malloc(g->nFree * sizeof(Vertex));
+      assert(c->removed != NULL && c->freeIds != NULL);
+      memcpy(c->removed, g->removed, g->nV * sizeof(bool));
+      memcpy(c->freeIds, g->freeIds, g->nFree * sizeof(Vertex));
+   }
+
+   if (g->sparse) {
+      c->poolLen = g->nE;
+      c->pool = malloc((c->poolLen + 1) * sizeof(Arc));
+      c->adj = malloc((g->nV + 1) * sizeof(Arc *));
+      c->deg = malloc((g->nV + 1) * sizeof(int));
+      c->cap = malloc((g->nV + 1) * sizeof(int));
+      assert(c->pool != NULL && c->adj != NULL && c->deg != NULL && c->cap != NULL);
+      memcpy(c->deg, g->deg, g->nV * sizeof(int));
+      memcpy(c->cap, g->deg, g->nV * sizeof(int));   // pooled lists are full
+      Arc *next = c->pool;
+      for (v = 0; v < g->nV; v++) {
+         if (g->deg[v] == 0) {
+            c->adj[v] = NULL;
+            continue;
+         }
+         c->adj[v] = next;
+         memcpy(next, g->adj[v], g->deg[v] * sizeof(Arc));
+         next += g->deg[v];
+      }
+   } else {
+      c->cells = malloc(((size_t)g->nV * g->nV + 1) * sizeof(int));
+      c->edges = malloc((g->nV + 1) * sizeof(int *));
+      assert(c->cells != NULL && c->edges != NULL);
+      for (v = 0; v < g->nV; v++) {
+         c->edges[v] = c->cells + (size_t)v * g->nV;
+         memcpy(c->edges[v], g->edges[v], g->nV * sizeof(int));
+      }
+   }
+   return c;
+}
+
+// start iterating over the outgoing edges of v
+void neighbours(Graph g, Vertex v, NeighbourIter *it) {
+   assert(g != NULL && validV(g,v) && it != NULL);
+   it->g = g;
+   it->v = v;
+   it->pos = -1;
+}
+
+// fetch the next neighbour of it->v into *w and the edge weight into *weight
+// returns false once all neighbours have been visited
+// O(outdeg(v)) in total for adjacency lists, O(V) for the matrix
+bool nextNeighbour(NeighbourIter *it, Vertex *w, int *weight) {
+   Graph g = it->g;
+
+   if (g->sparse) {
+      if (it->pos + 1 >= g->deg[it->v])
+         return false;
+      it->pos++;
+      *w = g->adj[it->v][it->pos].w;
+      *weight = g->adj[it->v][it->pos].weight;
+      return true;
+   }
+   while (++it->pos < g->nV) {
+      if (g->edges[it->v][it->pos] != 0) {
+         *w = it->pos;
+         *weight = g->edges[it->v][it->pos];
+         return true;
+      }
+   }
+   return false;
+}
+
+// number of outgoing edges of v
+int degree(Graph g, Vertex v) {
+   assert(g != NULL && validV(g,v));
+
+   if (g->sparse)
+      return g->deg[v];
+   int w, d = 0;
+   for (w = 0; w < g->nV; w++)
+      if (g->edges[v][w] != 0)
+         d++;
+   return d;
+}
+
+// growing and shrinking
+
+// make room for at least one more vertex: capacity doubles, so the cost of
+// moving everything is amortised over the vertices added since the last move
+static void growVertices(Graph g) {
+   int newCap = (g->vCap < 8) ? 16 : 2 * g->vCap, v;
+
+   if (g->sparse) {   // lists stay where they are, only the per-vertex arrays move
+      g->adj = realloc(g->adj, newCap * sizeof(Arc *));
+      g->deg = realloc(g->deg, newCap * sizeof(int));
+      g->cap = realloc(g->cap, newCap * sizeof(int));
+      assert(g->adj != NULL && g->deg != NULL && g->cap != NULL);
+   } else {           // rows get longer: copy them into a new matrix
+      int *cells = calloc((size_t)newCap * newCap, sizeof(int));
+      g->edges = realloc(g->edges, newCap * sizeof(int *));
+      assert(cells != NULL && g->edges != NULL);
+      for (v = 0; v < g->nV; v++)
+         memcpy(cells + (size_t)v * newCap, g->edges[v], g->nV * sizeof(int));
+      free(g->cells);
+      g->cells = cells;
+      for (v = 0; v < newCap; v++)
+         g->edges[v] = cells + (size_t)v * newCap;
+   }
+   if (g->removed != NULL) {
+      g->removed = realloc(g->removed, newCap * sizeof(bool));
+      assert(g->removed != NULL);
+   }
+   g->vCap = newCap;
+}
+
+// add a vertex without edges and return it; a removed vertex is reused if there is one
+// amortised O(1) for adjacency lists, O(V) for the matrix
+Vertex addVertex(Graph g) {
+   assert(g != NULL && g->map == NULL);
+   Vertex v;
+
+   if (g->nFree > 0) {   // removed vertices have no edges left, so reuse as is
+      v = g->freeIds[--g->nFree];
+      g->removed[v] = false;
+      return v;
+   }
+   if (g->nV == g->vCap)
+      growVertices(g);
+   v = g->nV++;
+   if (g->sparse) {
+      g->adj[v] = NULL;
+      g->deg[v] = g->cap[v] = 0;
+   }   // row and column v of the matrix are still 0 from calloc or removeVertex
+   if (g->removed != NULL)
+      g->removed[v] = false;
+   return v;
+}
+
+// remove all edges into and out of v and keep v for reuse by addVertex
+// O(V) for the matrix, O(V+E) for adjacency lists (incoming edges have to be searched for)
+// v stays a valid vertex without edges, so numOfVertices(g) does not change,
+// but no edges may be inserted at it until it is handed out again
+void removeVertex(Graph g, Vertex v) {
+   assert(g != NULL && validV(g,v) && g->map == NULL);
+   if (g->removed == NULL) {
+      g->removed = calloc(g->vCap + 1, sizeof(bool));
+      assert(g->removed != NULL);
+   }
+   assert(!g->removed[v]);
+   int u;
+
+   if (g->sparse) {
+      g->nE -= g->deg[v];
+      g->deg[v] = 0;
+      for (u = 0; u < g->nV; u++) {
+         int i = findArc(g, u, v);
+         if (i >= 0) {
+            g->adj[u][i] = g->adj[u][--g->deg[u]];
+            g->nE--;
+         }
+      }
+   } else {
+      for (u = 0; u < g->nV; u++) {
+         g->nE -= (g->edges[v][u] != 0) + (u != v && g->edges[u][v] != 0);
+         g->edges[v][u] = g->edges[u][v] = 0;
+      }
+   }
+   if (g->nFree == g->freeCap) {
+      g->freeCap = (g->freeCap == 0) ? 16 : 2 * g->freeCap;
+      g->freeIds = realloc(g->freeIds, g->freeCap * sizeof(Vertex));
+      assert(g->freeIds != NULL);
+   }
+   g->freeIds[g->nFree++] = v;
+   g->removed[v] = true;
+}
+
+// bulk construction
+
+typedef struct {
+   Graph       g;
+   const Edge *edges;
+   int        *key;     // source vertex of each edge
+   int        *start;   // partition of edges by source vertex
+   int        *order;
+   Arc        *arcs;    // sparse: arcs in partition order
+   Arc        *tmp;     // sparse: scratch space for sorting arcs
+   int        *count;   // #edges kept per worker
+} BuildArgs;
+
+static void edgeSources(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   int i;
+   for (i = lo; i < hi; i++) {
+      assert(validV(b->g,b->edges[i].v) && validV(b->g,b->edges[i].w));
+      b->key[i] = b->edges[i].v;
+   }
+   (void)worker;
+}
+
+// each worker owns whole rows, so no two threads write the same cell
+// edges of a row are visited in input order: the first weight wins, as with insertEdge
+static void fillRows(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   Graph g = b->g;
+   int v, i, n = 0;
+   for (v = lo; v < hi; v++) {
+      for (i = b->start[v]; i < b->start[v + 1]; i++) {
+         Edge e = b->edges[b->order[i]];
+         if (g->edges[v][e.w] == 0) {
+            g->edges[v][e.w] = e.weight;
+            n++;
+         }
+      }
+   }
+   b->count[worker] = n;
+}
+
+// stable merge sort of arcs by target, using tmp[] as scratch space of the same length
+static void sortArcs(Arc a[], Arc tmp[], int n) {
+   int width, i;
+   for (width = 1; width < n; width *= 2) {
+      for (i = 0; i < n; i += 2 * width) {
+         int lo = i, mid = i + width, hi = i + 2 * width, l, r, k;
+         if (mid > n) mid = n;
+         if (hi > n) hi = n;
+         for (l = lo, r = mid, k = lo; k < hi; k++) {
+            if (l < mid && (r >= hi || a[l].w <= a[r].w))
+               tmp[k] = a[l++];
+            else
+               tmp[k] = a[r++];
+         }
+      }
+      memcpy(a, tmp, n * sizeof(Arc));
+   }
+}
+
+// sort each row's arcs by target keeping input order among duplicates,
+// then keep only the first arc to each target, as insertEdge would
+static void gatherRows(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   Graph g = b->g;
+   int v, i, n = 0;
+   for (v = lo; v < hi; v++) {
+      Arc *row = b->arcs + b->start[v];
+      int len = b->start[v + 1] - b->start[v], d = 0;
+      for (i = 0; i < len; i++) {
+         Edge e = b->edges[b->order[b->start[v] + i]];
+         row[i].w = e.w;
+         row[i].weight = e.weight;
+      }
+      sortArcs(row, b->tmp + b->start[v], len);
+      for (i = 0; i < len; i++)
+         if (d == 0 || row[i].w != row[d - 1].w)
+            row[d++] = row[i];
+      g->deg[v] = g->cap[v] = d;
+      n += d;
+   }
+   b->count[worker] = n;
+}
+
+static void copyRows(int lo, int hi, int worker, void *arg) {
+   BuildArgs *b = arg;
+   Graph g = b->g;
+   int v;
+   for (v = lo; v < hi; v++)
+      if (g->deg[v] > 0)
+         memcpy(g->adj[v], b->arcs + b->start[v], g->deg[v] * sizeof(Arc));
+   (void)worker;
+}
+
+// partition the edges by source vertex and run fill over the rows in parallel
+// returns the number of edges kept
+static int buildRows(BuildArgs *b, int n, void (*fill)(int, int, int, void *)) {
+   Graph g = b->g;
+   int T = numWorkers(), t, nE = 0;
+   assert(n < INT_MAX);   // n + 1 below must not overflow
+   b->key = malloc((n + 1) * sizeof(int));
+   b->order = malloc((n + 1) * sizeof(int));
+   b->start = malloc((g->nV + 1) * sizeof(int));
+   b->count = calloc(T, sizeof(int));
+   assert(b->key != NULL && b->order != NULL && b->start != NULL && b->count != NULL);
+
+   parallelFor(n, edgeSources, b);
+   parallelPartition(n, b->key, g->nV, b->start, b->order);
+   parallelForWorkers(g->nV, T, fill, b);   // count[] has T entries
+   for (t = 0; t < T; t++)
+      nE += b->count[t];
+
+   free(b->key);
+   free(b->order);
+   free(b->count);
+   return nE;
+}
+
+// build a dense graph from n edges in parallel
+// for repeated edges the first weight in the array is kept, as by insertEdge
+Graph newGraphFromEdges(int V, const Edge edges[], int n) {
+   assert(n >= 0 && (n == 0 || edges != NULL));
+   Graph g = newGraph(V);
+   BuildArgs b;
+   b.g = g;
+   b.edges = edges;
+
+   g->nE = buildRows(&b, n, fillRows);
+   free(b.start);
+   return g;
+}
+
+// build a sparse graph from n edges in parallel; all lists share one pool
+Graph newSparseGraphFromEdges(int V, const Edge edges[], int n) {
+   assert(n >= 0 && (n == 0 || edges != NULL));
+   Graph g = newSparseGraph(V);
+   BuildArgs b;
+   b.g = g;
+   b.edges = edges;
+   b.arcs = malloc((n + 1) * sizeof(Arc));
+   b.tmp = malloc((n + 1) * sizeof(Arc));
+   assert(b.arcs != NULL && b.tmp != NULL);
+
+   g->nE = buildRows(&b, n, gatherRows);
+   free(b.tmp);
+
+   int v;
+   size_t total = 0;
+   g->poolLen = g->nE;
+   g->pool = malloc((g->poolLen + 1) * sizeof(Arc));
+   assert(g->pool != NULL);
+   for (v = 0; v < V; v++) {
+      g->adj[v] = (g->deg[v] > 0) ? g->pool + total : NULL;
+      total += g->deg[v];
+   }
+   parallelFor(V, copyRows, &b);
+
+   free(b.arcs);
+   free(b.start);
+   return g;
+}
+
+// binary file format
+
+#define WGRAPH_MAGIC   "9024WGRF"
+#define WGRAPH_VERSION 2   // 2: removed vertices are saved (SEC_FREE)
+
+enum { SEC_CELLS, SEC_DEG, SEC_ARCS, SEC_FREE, NUM_SECTIONS };
+
+// file = header, then each array at an 8-byte aligned offset, ready to be mapped
+typedef struct {
+   char     magic[8];
+   uint32_t version;
+   uint32_t sparse;
+   int32_t  nV, nE;
+   uint64_t poolLen;               // #entries in SEC_ARCS
+   uint64_t nFree;                 // #entries in SEC_FREE, the stack of removed vertices
+   uint64_t offset[NUM_SECTIONS];  // byte offset of each array
+   uint64_t fileLen;
+} WGraphFileHeader;
+
+// append len bytes at the next 8-byte boundary, recording where they went
+static bool writeSection(FILE *fp, const void *data, size_t len, uint64_t *offset) {
+   static const char zero[8] = { 0 };
+   long pos = ftell(fp);
+   if (pos < 0 || fwrite(zero, 1, (8 - pos % 8) % 8, fp) != (size_t)((8 - pos % 8) % 8))
+      return false;
+   *offset = (uint64_t)ftell(fp);
+   return len == 0 || fwrite(data, 1, len, fp) == len;
+}
+
+// write g to a file that loadGraph can map; returns 0 on success, -1 on I/O error
+int saveGraph(Graph g, const char *path) {
+   assert(g != NULL && path != NULL);
+   FILE *fp = fopen(path, "wb");
+   if (fp == NULL)
+      return -1;
+
+   WGraphFileHeader h;
+   memset(&h, 0, sizeof(h));
+   memcpy(h.magic, WGRAPH_MAGIC, 8);
+   h.version = WGRAPH_VERSION;
+   h.sparse = g->sparse;
+   h.nV = g->nV;
+   h.nE = g->nE;
+   h.nFree = g->nFree;
+
+   bool ok = fwrite(&h, sizeof(h), 1, fp) == 1;
+   int v;
+   if (g->sparse) {
+      ok = ok && writeSection(fp, g->deg, g->nV * sizeof(int), &h.offset[SEC_DEG]);
+      ok = ok && writeSection(fp, NULL, 0, &h.offset[SEC_ARCS]);
+      for (v = 0; ok && v < g->nV; v++) {   // adjacency lists back to back (CSR)
+         ok = g->deg[v] == 0 || fwrite(g->adj[v], sizeof(Arc), g->deg[v], fp) == (size_t)g->deg[v];
+         h.poolLen += g->deg[v];
+      }
+   } else {
+      ok = ok && writeSection(fp, NULL, 0, &h.offset[SEC_CELLS]);
+      for (v = 0; ok && v < g->nV; v++)     // rows in order, whatever their layout in memory
+         ok = fwrite(g->edges[v], sizeof(int), g->nV, fp) == (size_t)g->nV;
+   }
+   ok = ok && writeSection(fp, g->freeIds, g->nFree * sizeof(Vertex), &h.offset[SEC_FREE]);
+   if (ok) {   // now that the offsets are known, rewrite the header
+      h.fileLen = (uint64_t)ftell(fp);
+      ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, fp) == 1;
+   }
+   if (fclose(fp) != 0)
+      ok = false;
+   return ok ? 0 : -1;
+}
+
+// does an array of count items of the given size at offset lie inside the file?
+// offsets must also be 8-byte aligned and come after the header
+static bool sectionFits(uint64_t offset, uint64_t count, size_t size, uint64_t fileLen) {
+   return offset % 8 == 0 && offset >= sizeof(WGraphFileHeader) && offset <= fileLen &&
+          count <= (fileLen - offset) / size;
+}
+
+// check everything loadGraph takes from the header before any array is used;
+// for sparse graphs the degrees must also add up to the pool length
+// (weights and neighbours are trusted, as checking them would cost O(V + E))
+static bool headerValid(const WGraphFileHeader *h, const char *base) {
+   uint64_t len = h->fileLen;
+   if (h->sparse > 1 || h->nV < 0 || h->nE < 0 || h->nFree > (uint64_t)h->nV ||
+       !sectionFits(h->offset[SEC_FREE], h->nFree, sizeof(Vertex), len))
+      return false;
+   if (!h->sparse)
+      return sectionFits(h->offset[SEC_CELLS], (uint64_t)h->nV * h->nV, sizeof(int), len);
+
+   if (!sectionFits(h->offset[SEC_DEG], h->nV, sizeof(int), len) ||
+       !sectionFits(h->offset[SEC_ARCS], h->poolLen, sizeof(Arc), len))
+      return false;
+   const int *deg = (const int *)(base + h->offset[SEC_DEG]);
+   uint64_t total = 0;
+   int v;
+   for (v = 0; v < h->nV; v++) {
+      if (deg[v] < 0)
+         return false;
+      total += deg[v];
+   }
+   return total == h->poolLen;
+}
+
+// map a file written by saveGraph read-only; the matrix or the adjacency lists
+// are used straight from the mapping, so loading costs O(V) and processes
+// loading the same file share its pages
+// returns NULL if the file cannot be read, is not a weighted graph file or its
+// header does not match its contents
+// the result is read-only (insertEdge/removeEdge assert); copyGraph gives a writable copy
+Graph loadGraph(const char *path) {
+   assert(path != NULL);
+   int fd = open(path, O_RDONLY);
+   if (fd < 0)
+      return NULL;
+   struct stat st;
+   if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(WGraphFileHeader)) {
+      close(fd);
+      return NULL;
+   }
+   void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED)
+      return NULL;
+
+   const WGraphFileHeader *h = map;
+   if (memcmp(h->magic, WGRAPH_MAGIC, 8) != 0 || h->version != WGRAPH_VERSION ||
+       h->fileLen != (uint64_t)st.st_size || !headerValid(h, map)) {
+      munmap(map, st.st_size);
+      return NULL;
+   }
+
+   Graph g = malloc(sizeof(GraphRep));
+   assert(g != NULL);
+   char *base = map;
+   int v;
+   g->map = map;
+   g->mapLen = st.st_size;
+   g->sparse = h->sparse;
+   g->nV = h->nV;
+   g->nE = h->nE;
+   g->edges = NULL;
+   g->cells = NULL;
+   g->adj = NULL;
+   g->deg = g->cap = NULL;
+   g->pool = NULL;
+   g->poolLen = 0;
+   g->vCap = g->nV;
+   g->removed = NULL;
+   g->freeIds = (Vertex *)(base + h->offset[SEC_FREE]);
+   g->nFree = g->freeCap = h->nFree;
+
+   if (g->nFree > 0) {   // removed flags from the free stack, which must name distinct vertices
+      g->removed = calloc(g->nV, sizeof(bool));
+      assert(g->removed != NULL);
+      for (v = 0; v < g->nFree; v++) {
+         Vertex r = g->freeIds[v];
+         if (r < 0 || r >= g->nV || g->removed[r]) {
+            free(g->removed);
+            free(g);
+            munmap(map, st.st_size);
+            return NULL;
+         }
+         g->removed[r] = true;
+      }
+   }
+
+   if (g->sparse) {
+      g->deg = g->cap = (int *)(base + h->offset[SEC_DEG]);
+      g->pool = (Arc *)(base + h->offset[SEC_ARCS]);
+      g->poolLen = h->poolLen;
+      g->adj = malloc((g->nV + 1) * sizeof(Arc *));
+      assert(g->adj != NULL);
+      Arc *next = g->pool;
+      for (v = 0; v < g->nV; v++) {
+         g->adj[v] = next;
+         next += g->deg[v];
+      }
+   } else {
+      g->cells = (int *)(base + h->offset[SEC_CELLS]);
+      g->edges = malloc((g->nV + 1) * sizeof(int *));
+      assert(g->edges != NULL);
+      for (v = 0; v < g->nV; v++)
+         g->edges[v] = g->cells + (size_t)v * g->nV;
+   }
+   return g;
+}
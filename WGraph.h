@@ -1,4 +1,8 @@
 // Weighted Graph ADT interface ... COMP9024 25T1
+#ifndef WGRAPH_H
+#define WGRAPH_H
+
+#include <stdbool.h>
 
 typedef struct GraphRep *Graph;
 
@@ -12,10 +16,44 @@ typedef struct Edge {
    int    weight;
 } Edge;
 
-Graph newGraph(int);
+Graph newGraph(int);                    // dense graph (adjacency matrix)
+Graph newSparseGraph(int);              // sparse graph (adjacency lists)
+Graph newGraphFromEdges(int V, const Edge edges[], int n);        // bulk, parallel builds
+Graph newSparseGraphFromEdges(int V, const Edge edges[], int n);  // of the two above
 int   numOfVertices(Graph);
 void  insertEdge(Graph, Edge);
 void  removeEdge(Graph, Edge);
 int   adjacent(Graph, Vertex, Vertex);  // returns weight, or 0 if not adjacent
 void  showGraph(Graph);
-void  freeGraph(Graph);
\ No newline at end of file
+void  freeGraph(Graph);
+Graph copyGraph(Graph);                 // writable copy of a graph
+
+// vertices can be added at any time: amortised O(1) for sparse graphs, O(V) for dense ones
+// a removed vertex loses its edges and its id is handed out again by a later addVertex;
+// until then it stays in the graph as a vertex without edges that takes no new ones
+Vertex addVertex(Graph g);              // new vertex without edges
+void   removeVertex(Graph g, Vertex v);
+
+// binary files: saveGraph returns 0 on success, -1 on I/O error;
+// loadGraph maps the file read-only (NULL if unreadable) and the graph it
+// returns cannot be modified, use copyGraph for a writable copy;
+// removed vertices are saved too, so the copy's addVertex reuses them
+int   saveGraph(Graph g, const char *path);
+Graph loadGraph(const char *path);
+
+// iterate over the outgoing edges of v in O(outdeg(v)) (O(V) for dense graphs):
+//    NeighbourIter it;
+//    Vertex w;
+//    int weight;
+//    for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); ) ...
+typedef struct NeighbourIter {
+   Graph  g;
+   Vertex v;
+   int    pos;
+} NeighbourIter;
+
+void  neighbours(Graph g, Vertex v, NeighbourIter *it);
+bool  nextNeighbour(NeighbourIter *it, Vertex *w, int *weight);
+int   degree(Graph g, Vertex v);        // #outgoing edges of v
+
+#endif
@@ -0,0 +1,32 @@
+// Weighted Graph ADT specialised by weight type ... COMP9024 25T1
+// every specialisation is the same code, WGraphTImpl.h, compiled with its own types
+#include "WGraph.h"
+#include "WGraphT.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <float.h>
+
+#define WT_SUFFIX U8
+#define WT_T      uint8_t
+#define WT_D      int
+#define WT_MAX    UINT8_MAX
+#include "WGraphTImpl.h"
+
+#define WT_SUFFIX U16
+#define WT_T      uint16_t
+#define WT_D      int
+#define WT_MAX    UINT16_MAX
+#include "WGraphTImpl.h"
+
+#define WT_SUFFIX I32
+#define WT_T      int32_t
+#define WT_D      int64_t
+#define WT_MAX    INT32_MAX
+#include "WGraphTImpl.h"
+
+#define WT_SUFFIX F32
+#define WT_T      float
+#define WT_D      float
+#define WT_MAX    FLT_MAX
+#include "WGraphTImpl.h"
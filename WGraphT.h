@@ -0,0 +1,57 @@
+// Weighted Graph ADT specialised by weight type ... COMP9024 25T1
+// dense adjacency matrix holding the weights in one contiguous block of
+// 1, 2 or 4 bytes per cell (WGraph.h uses an int per cell plus row pointers);
+// a weight of 0 means "not adjacent", so edge weights must be nonzero
+//
+// one implementation (WGraphTImpl.h) is instantiated for each weight type:
+//    suffix   weight type   distance type used by relaxRow
+//    U8       uint8_t       int
+//    U16      uint16_t      int
+//    I32      int32_t       int64_t
+//    F32      float         float
+// e.g. WGraphU16 g = newWGraphU16(V); insertEdgeU16(g, v, w, 300);
+// the wg... macros at the end pick the right function from the graph's type
+#ifndef WGRAPHT_H
+#define WGRAPHT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define WGRAPHT_DECLARE(S, T, D)                                                     \
+   typedef struct WGraph##S##Rep *WGraph##S;                                         \
+   WGraph##S newWGraph##S(int V);                   /* graph with V vertices, no edges */ \
+   WGraph##S convertWGraph##S(struct GraphRep *g);  /* copy of a WGraph.h graph */   \
+   void      freeWGraph##S(WGraph##S g);                                             \
+   int       numOfVertices##S(WGraph##S g);                                          \
+   int       numOfEdges##S(WGraph##S g);                                             \
+   void      insertEdge##S(WGraph##S g, int v, int w, T weight);                     \
+   void      removeEdge##S(WGraph##S g, int v, int w);                               \
+   T         adjacent##S(WGraph##S g, int v, int w);  /* weight, or 0 if not adjacent */ \
+   const T  *graphRow##S(WGraph##S g, int v);         /* row v of the matrix, nV cells */ \
+   int       degree##S(WGraph##S g, int v);           /* #outgoing edges of v */     \
+   void      relaxRow##S(WGraph##S g, int v, D base, D dist[]);
+
+WGRAPHT_DECLARE(U8,  uint8_t,  int)
+WGRAPHT_DECLARE(U16, uint16_t, int)
+WGRAPHT_DECLARE(I32, int32_t,  int64_t)
+WGRAPHT_DECLARE(F32, float,    float)
+
+// relaxRow(g, v, base, dist) sets dist[w] = min(dist[w], base + weight(v,w))
+// for every edge v->w; it and degree are branch-free loops over one row that
+// the compiler vectorizes (gcc -O3), reading nV * sizeof(T) bytes per call
+
+#define WGRAPHT_SELECT(g, fn) _Generic((g),        \
+   WGraphU8:  fn##U8,  WGraphU16: fn##U16,         \
+   WGraphI32: fn##I32, WGraphF32: fn##F32)
+
+#define wgFree(g)                  WGRAPHT_SELECT(g, freeWGraph)(g)
+#define wgNumOfVertices(g)         WGRAPHT_SELECT(g, numOfVertices)(g)
+#define wgNumOfEdges(g)            WGRAPHT_SELECT(g, numOfEdges)(g)
+#define wgInsertEdge(g, v, w, wt)  WGRAPHT_SELECT(g, insertEdge)(g, v, w, wt)
+#define wgRemoveEdge(g, v, w)      WGRAPHT_SELECT(g, removeEdge)(g, v, w)
+#define wgAdjacent(g, v, w)        WGRAPHT_SELECT(g, adjacent)(g, v, w)
+#define wgGraphRow(g, v)           WGRAPHT_SELECT(g, graphRow)(g, v)
+#define wgDegree(g, v)             WGRAPHT_SELECT(g, degree)(g, v)
+#define wgRelaxRow(g, v, b, d)     WGRAPHT_SELECT(g, relaxRow)(g, v, b, d)
+
+#endif
@@ -0,0 +1,123 @@
+// Weighted Graph ADT specialised by weight type: implementation template ... COMP9024 25T1
+// included once per weight type by WGraphT.c, with
+//    WT_SUFFIX  name suffix (U8, U16, ...)
+//    WT_T       weight type
+//    WT_D       distance type of relaxRow
+//    WT_MAX     largest weight convertWGraph accepts
+// defined beforehand; they are undefined again at the end
+
+#define WT_PASTE(a, b) a##b
+#define WT_NAME(a, b)  WT_PASTE(a, b)
+#define WT_(name)      WT_NAME(name, WT_SUFFIX)
+#define WT_GRAPH       WT_(WGraph)
+#define WT_REP         WT_NAME(WT_GRAPH, Rep)
+
+struct WT_REP {
+   WT_T *cells;   // nV*nV weights, row after row; 0 if nodes not adjacent
+   int   nV;      // #vertices
+   int   nE;      // #edges
+};
+
+WT_GRAPH WT_(newWGraph)(int V) {
+   assert(V >= 0);
+
+   WT_GRAPH g = malloc(sizeof(struct WT_REP));
+   assert(g != NULL);
+   g->nV = V;
+   g->nE = 0;
+   g->cells = calloc((size_t)V * V + 1, sizeof(WT_T));
+   assert(g->cells != NULL);
+   return g;
+}
+
+// weights of g must be in 1..WT_MAX (or nonzero floats)
+WT_GRAPH WT_(convertWGraph)(Graph g) {
+   assert(g != NULL);
+   int nV = numOfVertices(g), v, w, weight;
+
+   WT_GRAPH c = WT_(newWGraph)(nV);
+   for (v = 0; v < nV; v++) {
+      NeighbourIter it;
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); ) {
+         assert(weight > 0 && weight <= WT_MAX);
+         c->cells[(size_t)v * nV + w] = (WT_T)weight;
+         c->nE++;
+      }
+   }
+   return c;
+}
+
+void WT_(freeWGraph)(WT_GRAPH g) {
+   assert(g != NULL);
+   free(g->cells);
+   free(g);
+}
+
+int WT_(numOfVertices)(WT_GRAPH g) {
+   return g->nV;
+}
+
+int WT_(numOfEdges)(WT_GRAPH g) {
+   return g->nE;
+}
+
+void WT_(insertEdge)(WT_GRAPH g, int v, int w, WT_T weight) {
+   assert(g != NULL && v >= 0 && v < g->nV && w >= 0 && w < g->nV);
+   assert(weight != 0);
+   WT_T *cell = &g->cells[(size_t)v * g->nV + w];
+
+   if (*cell == 0) {   // edge not in graph; as in WGraph.h the first weight stays
+      *cell = weight;
+      g->nE++;
+   }
+}
+
+void WT_(removeEdge)(WT_GRAPH g, int v, int w) {
+   assert(g != NULL && v >= 0 && v < g->nV && w >= 0 && w < g->nV);
+   WT_T *cell = &g->cells[(size_t)v * g->nV + w];
+
+   if (*cell != 0) {   // edge in graph
+      *cell = 0;
+      g->nE--;
+   }
+}
+
+WT_T WT_(adjacent)(WT_GRAPH g, int v, int w) {
+   assert(g != NULL && v >= 0 && v < g->nV && w >= 0 && w < g->nV);
+   return g->cells[(size_t)v * g->nV + w];
+}
+
+const WT_T *WT_(graphRow)(WT_GRAPH g, int v) {
+   assert(g != NULL && v >= 0 && v < g->nV);
+   return g->cells + (size_t)v * g->nV;
+}
+
+int WT_(degree)(WT_GRAPH g, int v) {
+   const WT_T *restrict row = WT_(graphRow)(g, v);
+   int w, n = g->nV, d = 0;
+   for (w = 0; w < n; w++)
+      d += (row[w] != 0);
+   return d;
+}
+
+// every dist[w] is rewritten, so the loop has no branches and no
+// conditional stores for the compiler to worry about
+void WT_(relaxRow)(WT_GRAPH g, int v, WT_D base, WT_D dist[]) {
+   const WT_T *restrict row = WT_(graphRow)(g, v);
+   WT_D *restrict d = dist;
+   int w, n = g->nV;
+   for (w = 0; w < n; w++) {
+      WT_D c = base + (WT_D)row[w];
+      d[w] = (row[w] != 0 && c < d[w]) ? c : d[w];
+   }
+}
+
+#undef WT_PASTE
+#undef WT_NAME
+#undef WT_
+#undef WT_GRAPH
+#undef WT_REP
+#undef WT_SUFFIX
+#undef WT_T
+#undef WT_D
+#undef WT_MAX
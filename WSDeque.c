@@ -0,0 +1,114 @@
+// Work-stealing deque ADT implementation ... COMP9024 25T1
+// the deque is item[top..bottom-1] of a circular array; the owner moves bottom,
+// thieves advance top with a CAS, and the owner only CASes top when it takes
+// the last item; orderings follow Le, Pop, Cohen & Zappa Nardelli (PPoPP 2013)
+// a full array is replaced by one twice the size; thieves may still be reading
+// the old one, so replaced arrays are only freed by dropWSDeque
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include "WSDeque.h"
+
+#define CACHE_LINE 64
+#define MIN_SIZE   16
+
+typedef struct Array {
+   int64_t       mask;   // size - 1, size a power of 2
+   struct Array *prev;   // array this one replaced
+   int           item[];
+} Array;
+
+typedef struct WSDequeRep {
+   _Alignas(CACHE_LINE) int64_t top;      // next item to steal
+   _Alignas(CACHE_LINE) int64_t bottom;   // next free slot
+   Array *array;
+} WSDequeRep;
+
+static Array *newArray(int64_t size, Array *prev) {
+   Array *a = malloc(sizeof(Array) + size * sizeof(int));
+   assert(a != NULL);
+   a->mask = size - 1;
+   a->prev = prev;
+   return a;
+}
+
+wsDeque newWSDeque(int capacity) {
+   assert(capacity >= 0);
+   wsDeque D = aligned_alloc(CACHE_LINE, sizeof(WSDequeRep));
+   assert(D != NULL);
+   int64_t size = MIN_SIZE;
+   while (size < capacity)
+      size *= 2;
+   D->array = newArray(size, NULL);
+   D->top = D->bottom = 0;
+   return D;
+}
+
+void dropWSDeque(wsDeque D) {
+   Array *a = D->array;
+   while (a != NULL) {
+      Array *prev = a->prev;
+      free(a);
+      a = prev;
+   }
+   free(D);
+}
+
+// owner only: copy item[top..bottom-1] into an array twice the size
+static Array *grow(wsDeque D, Array *a, int64_t top, int64_t bottom) {
+   Array *b = newArray(2 * (a->mask + 1), a);
+   int64_t i;
+   for (i = top; i < bottom; i++)
+      b->item[i & b->mask] = __atomic_load_n(&a->item[i & a->mask], __ATOMIC_RELAXED);
+   __atomic_store_n(&D->array, b, __ATOMIC_RELEASE);
+   return b;
+}
+
+void WSDequePush(wsDeque D, int v) {
+   int64_t b = __atomic_load_n(&D->bottom, __ATOMIC_RELAXED);
+   int64_t t = __atomic_load_n(&D->top, __ATOMIC_ACQUIRE);
+   Array *a = __atomic_load_n(&D->array, __ATOMIC_RELAXED);
+   if (b - t > a->mask)
+      a = grow(D, a, t, b);
+   __atomic_store_n(&a->item[b & a->mask], v, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+   __atomic_store_n(&D->bottom, b + 1, __ATOMIC_RELAXED);
+}
+
+bool WSDequePop(wsDeque D, int *v) {
+   int64_t b = __atomic_load_n(&D->bottom, __ATOMIC_RELAXED) - 1;
+   Array *a = __atomic_load_n(&D->array, __ATOMIC_RELAXED);
+   __atomic_store_n(&D->bottom, b, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);   // claim bottom before looking at top
+   int64_t t = __atomic_load_n(&D->top, __ATOMIC_RELAXED);
+   if (t > b) {                               // was empty
+      __atomic_store_n(&D->bottom, b + 1, __ATOMIC_RELAXED);
+      return false;
+   }
+   int x = __atomic_load_n(&a->item[b & a->mask], __ATOMIC_RELAXED);
+   if (t == b) {                              // last item: race the thieves for it
+      bool won = __atomic_compare_exchange_n(&D->top, &t, t + 1, false,
+                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+      __atomic_store_n(&D->bottom, b + 1, __ATOMIC_RELAXED);
+      if (!won)
+         return false;
+   }
+   *v = x;
+   return true;
+}
+
+int WSDequeSteal(wsDeque D, int *v) {
+   int64_t t = __atomic_load_n(&D->top, __ATOMIC_ACQUIRE);
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+   int64_t b = __atomic_load_n(&D->bottom, __ATOMIC_ACQUIRE);
+   if (t >= b)
+      return WS_EMPTY;
+   Array *a = __atomic_load_n(&D->array, __ATOMIC_ACQUIRE);
+   int x = __atomic_load_n(&a->item[t & a->mask], __ATOMIC_RELAXED);
+   if (!__atomic_compare_exchange_n(&D->top, &t, t + 1, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+      return WS_ABORT;
+   *v = x;
+   return WS_STOLEN;
+}
@@ -0,0 +1,16 @@
+// Work-stealing deque ADT header file ... COMP9024 25T1
+// Chase-Lev deque of ints: one owner thread pushes and pops at the bottom
+// (LIFO), any other thread may steal from the top (FIFO); grows when full
+#include <stdbool.h>
+
+typedef struct WSDequeRep *wsDeque;
+
+#define WS_STOLEN 0    // WSDequeSteal results
+#define WS_EMPTY  1
+#define WS_ABORT  2    // lost a race with another thief or the owner, try again
+
+wsDeque newWSDeque(int capacity);         // empty deque with room for capacity ints
+void    dropWSDeque(wsDeque);             // remove unwanted deque (no thread may still be using it)
+void    WSDequePush(wsDeque, int);        // owner only: insert an int at the bottom
+bool    WSDequePop(wsDeque, int *v);      // owner only: remove bottom int into *v, false if empty
+int     WSDequeSteal(wsDeque, int *v);    // any thread: remove top int into *v
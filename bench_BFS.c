@@ -0,0 +1,84 @@
+// Benchmark: direction-optimizing parallel BFS vs. a textbook Queue-based BFS
+// gcc -O2 -pthread -o bench_BFS bench_BFS.c BFS.c Graph.c Parallel.c Queue.c
+// usage: ./bench_BFS [#vertices] [average degree] [#threads]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "BFS.h"
+#include "Parallel.h"
+#include "Queue.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// one node per enqueue, neighbours via the iterator
+static void queueBFS(Graph g, Vertex src, int dist[]) {
+   int nV = numOfVertices(g), v;
+   for (v = 0; v < nV; v++)
+      dist[v] = NOT_REACHED;
+   dist[src] = 0;
+
+   queue Q = newQueue();
+   QueueEnqueue(Q, src);
+   while (!QueueIsEmpty(Q)) {
+      Vertex u = QueueDequeue(Q), w;
+      NeighbourIter it;
+      for (neighbours(g, u, &it); nextNeighbour(&it, &w); ) {
+         if (dist[w] == NOT_REACHED) {
+            dist[w] = dist[u] + 1;
+            QueueEnqueue(Q, w);
+         }
+      }
+   }
+   dropQueue(Q);
+}
+
+int main(int argc, char *argv[]) {
+   int nV  = (argc > 1) ? atoi(argv[1]) : 1000000;
+   int avg = (argc > 2) ? atoi(argv[2]) : 16;
+   if (argc > 3)
+      setNumWorkers(atoi(argv[3]));
+
+   int nE = (int)((long long)nV * avg / 2), i, v;
+   Edge *edges = malloc(nE * sizeof(Edge));
+   assert(edges != NULL);
+   srand(9024);
+   for (i = 0; i < nE; i++) {
+      edges[i].v = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      edges[i].w = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+   }
+   Graph g = newSparseGraphFromEdges(nV, edges, nE);
+   free(edges);
+
+   int    *d1 = malloc(nV * sizeof(int));
+   int    *d2 = malloc(nV * sizeof(int));
+   Vertex *parent = malloc(nV * sizeof(Vertex));
+   assert(d1 != NULL && d2 != NULL && parent != NULL);
+
+   double t0 = seconds();
+   queueBFS(g, 0, d1);
+   double t1 = seconds();
+   bfs(g, 0, parent, d2);
+   double t2 = seconds();
+
+   int reached = 0;
+   for (v = 0; v < nV; v++) {
+      assert(d1[v] == d2[v]);
+      if (d1[v] != NOT_REACHED)
+         reached++;
+   }
+   printf("%d vertices, %d edges, %d reached, %d threads\n", nV, nE, reached, numWorkers());
+   printf("Queue BFS:                 %8.3f s\n", t1 - t0);
+   printf("direction-optimizing BFS:  %8.3f s (%.1fx)\n", t2 - t1, (t1 - t0) / (t2 - t1));
+
+   free(d1);
+   free(d2);
+   free(parent);
+   freeGraph(g);
+   return 0;
+}
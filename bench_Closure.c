@@ -0,0 +1,107 @@
+// Benchmark: transitiveClosure on 1, 2, 4, ... workers, checked against a DFS from every vertex
+// gcc -O2 -pthread -o bench_Closure bench_Closure.c Closure.c Graph.c Parallel.c
+// gcc -O2 -pthread -DWGRAPH -o bench_Closure bench_Closure.c Closure.c WGraph.c Parallel.c
+// usage: ./bench_Closure [#vertices] [average degree] [largest #threads]
+// Graph.h graphs are undirected, WGraph.h graphs (-DWGRAPH) directed
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "Closure.h"
+#include "Parallel.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// mark[w] = src for every w reachable from src; stack[] has room for all vertices
+static void dfs(Graph g, Vertex src, int mark[], Vertex stack[]) {
+   int top = 0;
+   Vertex w;
+   mark[src] = src;
+   stack[top++] = src;
+   while (top > 0) {
+      Vertex v = stack[--top];
+      NeighbourIter it;
+#ifdef WGRAPH
+      int weight;
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); )
+#else
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w); )
+#endif
+         if (mark[w] != src) {
+            mark[w] = src;
+            stack[top++] = w;
+         }
+   }
+}
+
+int main(int argc, char *argv[]) {
+   int nV   = (argc > 1) ? atoi(argv[1]) : 4000;   // not a multiple of 64: the last pivot block is short
+   int avg  = (argc > 2) ? atoi(argv[2]) : 4;
+   int maxT = (argc > 3) ? atoi(argv[3]) : numWorkers();
+   int nE = (int)((long long)nV * avg / 2), i, T;
+   Vertex v, w;
+
+   Edge *edges = malloc((nE + 1) * sizeof(Edge));
+   assert(edges != NULL);
+   srand(9024);
+   for (i = 0; i < nE; i++) {
+      edges[i].v = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      edges[i].w = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+#ifdef WGRAPH
+      edges[i].weight = 1;
+#endif
+   }
+   Graph g = newSparseGraphFromEdges(nV, edges, nE);
+   free(edges);
+
+   int    *mark  = malloc((nV + 1) * sizeof(int));
+   Vertex *stack = malloc((nV + 1) * sizeof(Vertex));
+   assert(mark != NULL && stack != NULL);
+   for (v = 0; v < nV; v++)
+      mark[v] = -1;
+
+   setNumWorkers(1);
+   double t0 = seconds();
+   Closure c1 = transitiveClosure(g);
+   double t1 = seconds();
+   double base = t1 - t0;
+   long long pairs = 0;
+   for (v = 0; v < nV; v++) {
+      dfs(g, v, mark, stack);
+      for (w = 0; w < nV; w++) {
+         assert(reachable(c1, v, w) == (mark[w] == v));
+         pairs += (mark[w] == v);
+      }
+   }
+#ifdef WGRAPH
+   printf("WGraph (directed): ");
+#else
+   printf("Graph (undirected): ");
+#endif
+   printf("%d vertices, average degree %d, %lld reachable pairs\n", nV, avg, pairs);
+   printf("%8s %10s %10s\n", "threads", "seconds", "speedup");
+   printf("%8d %10.3f %10s\n", 1, base, "1.00");
+
+   for (T = 2; T <= maxT; T = (T < maxT && 2 * T > maxT) ? maxT : 2 * T) {   // 2, 4, ..., maxT
+      setNumWorkers(T);
+      t0 = seconds();
+      Closure c = transitiveClosure(g);
+      t1 = seconds();
+      for (v = 0; v < nV; v++)
+         for (w = 0; w < nV; w++)
+            assert(reachable(c, v, w) == reachable(c1, v, w));
+      printf("%8d %10.3f %10.2f\n", T, t1 - t0, base / (t1 - t0));
+      freeClosure(c);
+   }
+
+   freeClosure(c1);
+   free(mark);
+   free(stack);
+   freeGraph(g);
+   return 0;
+}
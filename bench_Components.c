@@ -0,0 +1,110 @@
+// Benchmark: connected components by sequential Stack DFS vs. connectedComponents on 1, 2, 4, ... workers
+// gcc -O2 -pthread -o bench_Components bench_Components.c Components.c UnionFind.c Stack.c Graph.c Parallel.c
+// usage: ./bench_Components [#vertices] [average degree] [largest #threads]
+// a dense graph on at most 4000 of the vertices is checked and timed as well
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "Components.h"
+#include "Parallel.h"
+#include "Stack.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// components numbered in order of their smallest vertex, as connectedComponents does
+static int stackComponents(Graph g, int comp[], int size[]) {
+   int nV = numOfVertices(g), k = 0, v;
+   Vertex w;
+   stack S = newStackReserve(nV);
+   for (v = 0; v < nV; v++)
+      comp[v] = -1;
+   for (v = 0; v < nV; v++) {
+      if (comp[v] >= 0)
+         continue;
+      size[k] = 0;
+      comp[v] = k;
+      StackPush(S, v);
+      while (!StackIsEmpty(S)) {
+         Vertex u = StackPop(S);
+         size[k]++;
+         NeighbourIter it;
+         for (neighbours(g, u, &it); nextNeighbour(&it, &w); )
+            if (comp[w] < 0) {
+               comp[w] = k;
+               StackPush(S, w);
+            }
+      }
+      k++;
+   }
+   dropStack(S);
+   return k;
+}
+
+static Graph randomGraph(int nV, int nE, bool sparse) {
+   Edge *edges = malloc((nE + 1) * sizeof(Edge));
+   assert(edges != NULL);
+   int i;
+   for (i = 0; i < nE; i++) {
+      edges[i].v = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      edges[i].w = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+   }
+   Graph g = sparse ? newSparseGraphFromEdges(nV, edges, nE) : newGraphFromEdges(nV, edges, nE);
+   free(edges);
+   return g;
+}
+
+static void run(Graph g, const char *name, int avg, int maxT) {
+   int nV = numOfVertices(g), v, T;
+   int *comp1 = malloc((nV + 1) * sizeof(int)), *size1 = malloc((nV + 1) * sizeof(int));
+   int *comp2 = malloc((nV + 1) * sizeof(int)), *size2 = malloc((nV + 1) * sizeof(int));
+   assert(comp1 != NULL && size1 != NULL && comp2 != NULL && size2 != NULL);
+
+   double t0 = seconds();
+   int k = stackComponents(g, comp1, size1);
+   double t1 = seconds();
+   double base = t1 - t0;
+   printf("%s: %d vertices, average degree %d, %d components\n", name, nV, avg, k);
+   printf("%8s %10s %10s\n", "threads", "seconds", "speedup");
+   printf("%8s %10.3f %10s\n", "Stack", base, "1.00");
+
+   for (T = 1; T <= maxT; T = (T < maxT && 2 * T > maxT) ? maxT : 2 * T) {   // 1, 2, 4, ..., maxT
+      setNumWorkers(T);
+      t0 = seconds();
+      int k2 = connectedComponents(g, comp2, size2);
+      t1 = seconds();
+      assert(k2 == k);
+      for (v = 0; v < nV; v++)
+         assert(comp2[v] == comp1[v]);
+      for (v = 0; v < k; v++)
+         assert(size2[v] == size1[v]);
+      printf("%8d %10.3f %10.2f\n", T, t1 - t0, base / (t1 - t0));
+   }
+
+   free(comp1);
+   free(size1);
+   free(comp2);
+   free(size2);
+}
+
+int main(int argc, char *argv[]) {
+   int nV   = (argc > 1) ? atoi(argv[1]) : 4000000;
+   int avg  = (argc > 2) ? atoi(argv[2]) : 2;   // around the giant component threshold
+   int maxT = (argc > 3) ? atoi(argv[3]) : numWorkers();
+   int dV   = (nV < 4000) ? nV : 4000;
+
+   srand(9024);
+   Graph g = randomGraph(nV, (int)((long long)nV * avg / 2), true);
+   run(g, "sparse", avg, maxT);
+   freeGraph(g);
+
+   g = randomGraph(dV, (int)((long long)dV * avg / 2), false);
+   run(g, "dense", avg, maxT);
+   freeGraph(g);
+   return 0;
+}
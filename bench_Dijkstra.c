@@ -0,0 +1,137 @@
+// Benchmark: Dijkstra with the indexed heap vs. the bucket queue workspace
+// gcc -O2 -pthread -o bench_Dijkstra bench_Dijkstra.c Dijkstra.c IHeap.c BucketQueue.c APSP.c WGraph.c Parallel.c
+// usage: ./bench_Dijkstra [#vertices] [average degree] [largest weight]
+// both workspaces are first checked against allPairsShortestPaths on small dense
+// and sparse graphs, including every shortestPath and its cost
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "Dijkstra.h"
+#include "APSP.h"
+
+#define CHECK_V 300   // vertices of the graphs checked against APSP
+#define SOURCES 8     // searches timed per workspace
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static int randomBelow(int n) {
+   return (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % (unsigned)n);
+}
+
+static Graph randomGraph(int nV, int nE, int maxWeight, bool sparse) {
+   Edge *edges = malloc((nE + 1) * sizeof(Edge));
+   assert(edges != NULL);
+   int i;
+   for (i = 0; i < nE; i++) {
+      edges[i].v = randomBelow(nV);
+      edges[i].w = randomBelow(nV);
+      edges[i].weight = 1 + randomBelow(maxWeight);
+   }
+   Graph g = sparse ? newSparseGraphFromEdges(nV, edges, nE) : newGraphFromEdges(nV, edges, nE);
+   free(edges);
+   return g;
+}
+
+// every distance, and every path shortestPath gives, agrees with d[] from APSP
+static void checkWork(Graph g, const int d[], DijkstraWork work) {
+   int nV = numOfVertices(g), src, dst, i;
+   int    *dist = malloc(nV * sizeof(int));
+   Vertex *pred = malloc(nV * sizeof(Vertex));
+   Vertex *path = malloc(nV * sizeof(Vertex));
+   assert(dist != NULL && pred != NULL && path != NULL);
+
+   for (src = 0; src < nV; src++) {
+      dijkstra(g, src, -1, dist, pred, work);
+      for (dst = 0; dst < nV; dst++) {
+         assert(dist[dst] == d[src * nV + dst]);
+         if (dst == src || dist[dst] == NO_PATH)
+            assert(pred[dst] == -1);
+         else
+            assert(dist[pred[dst]] + adjacent(g, pred[dst], dst) == dist[dst]);
+      }
+      for (dst = 0; dst < nV; dst++) {
+         int cost = -1, sum = 0;
+         int n = shortestPath(g, src, dst, path, &cost, work);
+         if (d[src * nV + dst] == NO_PATH) {
+            assert(n == 0);
+            continue;
+         }
+         assert(n > 0 && path[0] == src && path[n - 1] == dst && cost == d[src * nV + dst]);
+         for (i = 0; i + 1 < n; i++) {
+            int weight = adjacent(g, path[i], path[i + 1]);
+            assert(weight > 0);
+            sum += weight;
+         }
+         assert(sum == cost);
+      }
+   }
+   free(dist);
+   free(pred);
+   free(path);
+}
+
+static void check(bool sparse, int maxWeight) {
+   Graph g = randomGraph(CHECK_V, 5 * CHECK_V, maxWeight, sparse);
+   int *d = allPairsShortestPaths(g);
+   DijkstraWork heap = newDijkstraWork(CHECK_V);
+   DijkstraWork buckets = newDijkstraWorkBuckets(CHECK_V, maxWeight);
+   checkWork(g, d, heap);
+   checkWork(g, d, buckets);
+   dropDijkstraWork(heap);
+   dropDijkstraWork(buckets);
+   free(d);
+   freeGraph(g);
+}
+
+// SOURCES full searches; dist[] of the last one is left in dist
+static double timeSearches(Graph g, const Vertex src[], int dist[], DijkstraWork work) {
+   int i;
+   double t0 = seconds();
+   for (i = 0; i < SOURCES; i++)
+      dijkstra(g, src[i], -1, dist, NULL, work);
+   return seconds() - t0;
+}
+
+int main(int argc, char *argv[]) {
+   int nV   = (argc > 1) ? atoi(argv[1]) : 1000000;
+   int avg  = (argc > 2) ? atoi(argv[2]) : 8;
+   int maxW = (argc > 3) ? atoi(argv[3]) : 100;
+   assert(nV > 0 && avg >= 0 && maxW > 0);
+   int v, i;
+
+   srand(9024);
+   check(false, maxW);
+   check(true, maxW);
+   printf("heap and bucket workspaces match APSP on %d-vertex dense and sparse graphs\n", CHECK_V);
+
+   Graph g = randomGraph(nV, (int)((long long)nV * avg), maxW, true);
+   Vertex src[SOURCES];
+   for (i = 0; i < SOURCES; i++)
+      src[i] = randomBelow(nV);
+   int *d1 = malloc(nV * sizeof(int)), *d2 = malloc(nV * sizeof(int));
+   assert(d1 != NULL && d2 != NULL);
+
+   DijkstraWork heap = newDijkstraWork(nV);
+   DijkstraWork buckets = newDijkstraWorkBuckets(nV, maxW);
+   double th = timeSearches(g, src, d1, heap);
+   double tb = timeSearches(g, src, d2, buckets);
+   for (v = 0; v < nV; v++)
+      assert(d1[v] == d2[v]);
+
+   printf("%d vertices, %d arcs per vertex, weights 1..%d, %d searches\n", nV, avg, maxW, SOURCES);
+   printf("indexed heap:  %8.3f s\n", th);
+   printf("bucket queue:  %8.3f s (%.1fx)\n", tb, th / tb);
+
+   dropDijkstraWork(heap);
+   dropDijkstraWork(buckets);
+   free(d1);
+   free(d2);
+   freeGraph(g);
+   return 0;
+}
@@ -0,0 +1,75 @@
+// Benchmark: building a set of n distinct ints and looking them up with List, UList and hashed UList
+// gcc -O3 -march=native -pthread -o bench_List bench_List.c List.c UList.c Pool.c
+// usage: ./bench_List [largest n] [largest n for List]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "List.h"
+#include "UList.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// build from x[0..n-1], then look up every x[i] and n absent values;
+// returns the number of hits, which must be n
+static int listRun(const int x[], int n) {
+   int i, hits = 0;
+   List L = NULL;
+   for (i = 0; i < n; i++)
+      L = insertLL(L, x[i]);
+   for (i = 0; i < n; i++)
+      hits += inLL(L, x[i]) + inLL(L, -1 - x[i]);
+   freeLL(L);
+   return hits;
+}
+
+static int ulistRun(const int x[], int n, bool hashed) {
+   int i, hits = 0;
+   UList L = hashed ? newUListHashed() : newUList();
+   for (i = 0; i < n; i++)
+      insertUL(L, x[i]);
+   for (i = 0; i < n; i++)
+      hits += inUL(L, x[i]) + inUL(L, -1 - x[i]);
+   freeUList(L);
+   return hits;
+}
+
+int main(int argc, char *argv[]) {
+   int maxN    = (argc > 1) ? atoi(argv[1]) : 1000000;
+   int maxList = (argc > 2) ? atoi(argv[2]) : 20000;
+   int n, i;
+
+   printf("%10s %12s %12s %12s\n", "n", "List", "UList", "UList+hash");
+   for (n = 1000; n <= maxN; n *= 10) {
+      int *x = malloc(n * sizeof(int));
+      assert(x != NULL);
+      for (i = 0; i < n; i++)            // distinct values >= 0 in scrambled order
+         x[i] = (int)(((unsigned)i * 2654435761u) & 0x7fffffff);
+
+      printf("%10d ", n);
+      double t0 = seconds();
+      if (n <= maxList) {
+         assert(listRun(x, n) == n);
+         printf("%10.4f s ", seconds() - t0);
+      } else {
+         printf("%12s ", "-");
+      }
+      double t1 = seconds();
+      if (n <= 10 * maxList) {           // the scan is still O(n) per lookup
+         assert(ulistRun(x, n, false) == n);
+         printf("%10.4f s ", seconds() - t1);
+      } else {
+         printf("%12s ", "-");
+      }
+      double t2 = seconds();
+      assert(ulistRun(x, n, true) == n);
+      printf("%10.4f s\n", seconds() - t2);
+      free(x);
+   }
+   return 0;
+}
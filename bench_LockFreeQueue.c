@@ -0,0 +1,179 @@
+// Benchmark: SPSC and MPMC lock-free queues vs. a mutex around the Queue ADT
+// gcc -O2 -pthread -o bench_LockFreeQueue bench_LockFreeQueue.c SPSCQueue.c MPMCQueue.c Queue.c
+// usage: ./bench_LockFreeQueue [#items] [#producers = #consumers for MPMC] [capacity]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "SPSCQueue.h"
+#include "MPMCQueue.h"
+#include "Queue.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// items are 1..n (never NULL); every consumer sums what it receives
+typedef struct {
+   spscQueue spsc;
+   mpmcQueue mpmc;
+   long      first, last;   // this thread's items
+   long      sum;           // consumer: sum of items received
+} Stage;
+
+// baseline: the Queue ADT behind a mutex, bounded to the same capacity by hand
+static queue           locked;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static int             lockedCount, lockedCapacity;
+
+static void *spscProducer(void *arg) {
+   Stage *s = arg;
+   for (long i = s->first; i <= s->last; i++)
+      SPSCEnqueue(s->spsc, (void *)(intptr_t)i);
+   return NULL;
+}
+
+static void *spscConsumer(void *arg) {
+   Stage *s = arg;
+   for (long i = s->first; i <= s->last; i++)
+      s->sum += (intptr_t)SPSCDequeue(s->spsc);
+   return NULL;
+}
+
+static void *mpmcProducer(void *arg) {
+   Stage *s = arg;
+   for (long i = s->first; i <= s->last; i++)
+      MPMCEnqueue(s->mpmc, (void *)(intptr_t)i);
+   return NULL;
+}
+
+static void *mpmcConsumer(void *arg) {
+   Stage *s = arg;
+   for (long i = s->first; i <= s->last; i++)
+      s->sum += (intptr_t)MPMCDequeue(s->mpmc);
+   return NULL;
+}
+
+static void *lockedProducer(void *arg) {
+   Stage *s = arg;
+   for (long i = s->first; i <= s->last; ) {
+      pthread_mutex_lock(&lock);
+      bool ok = lockedCount < lockedCapacity;
+      if (ok) {
+         QueueEnqueue(locked, (int)i++);
+         lockedCount++;
+      }
+      pthread_mutex_unlock(&lock);
+      if (!ok)
+         sched_yield();
+   }
+   return NULL;
+}
+
+static void *lockedConsumer(void *arg) {
+   Stage *s = arg;
+   for (long i = s->first; i <= s->last; ) {
+      pthread_mutex_lock(&lock);
+      bool ok = lockedCount > 0;
+      if (ok) {
+         s->sum += QueueDequeue(locked);
+         lockedCount--;
+         i++;
+      }
+      pthread_mutex_unlock(&lock);
+      if (!ok)
+         sched_yield();
+   }
+   return NULL;
+}
+
+// nT producers and nT consumers, each moving n/nT items; returns seconds taken
+static double run(void *(*producer)(void *), void *(*consumer)(void *),
+                  int nT, long n, spscQueue spsc, mpmcQueue mpmc) {
+   pthread_t *tid = malloc(2 * nT * sizeof(pthread_t));
+   Stage *st = calloc(2 * nT, sizeof(Stage));
+   assert(tid != NULL && st != NULL);
+   long per = n / nT, total = 0;
+   int t;
+   double t0 = seconds();
+   for (t = 0; t < 2 * nT; t++) {
+      st[t].spsc = spsc;
+      st[t].mpmc = mpmc;
+      st[t].first = (t % nT) * per + 1;
+      st[t].last  = (t % nT + 1) * per;
+      pthread_create(&tid[t], NULL, t < nT ? producer : consumer, &st[t]);
+   }
+   for (t = 0; t < 2 * nT; t++)
+      pthread_join(tid[t], NULL);
+   double t1 = seconds();
+   for (t = nT; t < 2 * nT; t++)
+      total += st[t].sum;
+   assert(total == nT * per * (nT * per + 1) / 2);   // every item arrived exactly once
+   free(tid);
+   free(st);
+   return t1 - t0;
+}
+
+// latency: one item bounces between two threads through a pair of SPSC queues
+static spscQueue ping, pong;
+static long rounds;
+
+static void *echo(void *arg) {
+   (void)arg;
+   for (long i = 0; i < rounds; i++)
+      SPSCEnqueue(pong, SPSCDequeue(ping));
+   return NULL;
+}
+
+int main(int argc, char *argv[]) {
+   long n       = (argc > 1) ? atol(argv[1]) : 10000000;
+   int  nT      = (argc > 2) ? atoi(argv[2]) : 2;
+   int  cap     = (argc > 3) ? atoi(argv[3]) : 1024;
+   double t;
+
+   printf("%ld items, capacity %d\n", n, cap);
+   printf("%-24s %10s %14s\n", "queue", "seconds", "Mitems/s");
+
+   spscQueue sq = newSPSCQueue(cap);
+   t = run(spscProducer, spscConsumer, 1, n, sq, NULL);
+   printf("%-24s %10.3f %14.1f\n", "SPSC 1p/1c", t, n / t * 1e-6);
+   dropSPSCQueue(sq);
+
+   mpmcQueue mq = newMPMCQueue(cap);
+   t = run(mpmcProducer, mpmcConsumer, 1, n, NULL, mq);
+   printf("%-24s %10.3f %14.1f\n", "MPMC 1p/1c", t, n / t * 1e-6);
+   t = run(mpmcProducer, mpmcConsumer, nT, n, NULL, mq);
+   printf("MPMC %dp/%dc%*s %10.3f %14.1f\n", nT, nT, 24 - 10, "", t, n / t * 1e-6);
+   dropMPMCQueue(mq);
+
+   locked = newQueueReserve(cap);
+   lockedCapacity = cap;
+   t = run(lockedProducer, lockedConsumer, 1, n, NULL, NULL);
+   printf("%-24s %10.3f %14.1f\n", "mutex+Queue 1p/1c", t, n / t * 1e-6);
+   t = run(lockedProducer, lockedConsumer, nT, n, NULL, NULL);
+   printf("mutex+Queue %dp/%dc%*s %10.3f %14.1f\n", nT, nT, 24 - 17, "", t, n / t * 1e-6);
+   dropQueue(locked);
+
+   rounds = n / 100;
+   ping = newSPSCQueue(1);
+   pong = newSPSCQueue(1);
+   pthread_t tid;
+   pthread_create(&tid, NULL, echo, NULL);
+   double t0 = seconds();
+   for (long i = 0; i < rounds; i++) {
+      SPSCEnqueue(ping, (void *)(intptr_t)(i + 1));
+      assert((intptr_t)SPSCDequeue(pong) == i + 1);
+   }
+   double t1 = seconds();
+   pthread_join(tid, NULL);
+   printf("SPSC round trip: %.0f ns over %ld rounds\n", (t1 - t0) / rounds * 1e9, rounds);
+   dropSPSCQueue(ping);
+   dropSPSCQueue(pong);
+   return 0;
+}
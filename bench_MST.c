@@ -0,0 +1,109 @@
+// Benchmark: Prim (PQueue ADO / indexed heap) and parallel Kruskal across graph densities
+// gcc -O2 -pthread -o bench_MST bench_MST.c MST.c WGraph.c IHeap.c UnionFind.c Parallel.c PQueue.c
+// usage: ./bench_MST [#vertices] [#threads]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include <limits.h>
+#include "MST.h"
+#include "PQueue.h"
+#include "Parallel.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// textbook Prim over the PQueue ADO
+static long long pqueuePrim(Graph g) {
+   int nV = numOfVertices(g), v, w, weight;
+   long long sum = 0;
+   int  *key = malloc(nV * sizeof(int));
+   bool *done = calloc(nV, sizeof(bool));
+   assert(key != NULL && done != NULL);
+   for (v = 0; v < nV; v++)
+      key[v] = INT_MAX;
+
+   PQueueInit();
+   for (v = 0; v < nV; v++) {
+      if (done[v])
+         continue;
+      key[v] = 0;
+      joinPQueue(v);
+      while (!PQueueIsEmpty()) {
+         Vertex u = leavePQueue(key);
+         if (done[u])
+            continue;
+         done[u] = true;
+         sum += key[u];
+         NeighbourIter it;
+         for (neighbours(g, u, &it); nextNeighbour(&it, &w, &weight); ) {
+            if (!done[w] && weight < key[w]) {
+               key[w] = weight;
+               joinPQueue(w);
+            }
+         }
+      }
+   }
+   free(key);
+   free(done);
+   return sum;
+}
+
+// random undirected graph with about avg edges per vertex, stored both ways
+static Graph randomGraph(int nV, int avg, bool sparse) {
+   int n = (int)((long long)nV * avg / 2), i;
+   Edge *edges = malloc(2 * (size_t)n * sizeof(Edge));
+   assert(edges != NULL);
+   for (i = 0; i < n; i++) {
+      int v = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      int w = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      int weight = 1 + rand() % 1000;
+      edges[2 * i] = (Edge){ v, w, weight };
+      edges[2 * i + 1] = (Edge){ w, v, weight };
+   }
+   Graph g = sparse ? newSparseGraphFromEdges(nV, edges, 2 * n) : newGraphFromEdges(nV, edges, 2 * n);
+   free(edges);
+   return g;
+}
+
+int main(int argc, char *argv[]) {
+   int nV = (argc > 1) ? atoi(argv[1]) : 1000;
+   if (argc > 2)
+      setNumWorkers(atoi(argv[2]));
+   static const int density[] = { 4, 16, 64, 256 };   // average degree
+   int d;
+
+   Edge *tree = malloc(nV * sizeof(Edge));
+   assert(tree != NULL);
+   printf("%d vertices, %d threads\n", nV, numWorkers());
+   printf("%8s %10s %14s %14s %14s %14s\n", "avg deg", "weight", "Prim/PQueue", "Prim/IHeap", "Kruskal/lists", "Kruskal/matrix");
+   for (d = 0; d < (int)(sizeof(density) / sizeof(density[0])); d++) {
+      srand(9024 + d);   // same edges in both representations, so the totals must agree
+      Graph dense = randomGraph(nV, density[d], false);
+      srand(9024 + d);
+      Graph sparse = randomGraph(nV, density[d], true);
+
+      long long t1, t2, t3, t4;
+      double s0 = seconds();
+      t4 = pqueuePrim(dense);
+      double s1 = seconds();
+      primMST(dense, tree, &t1);
+      double s2 = seconds();
+      kruskalMST(sparse, tree, &t2);
+      double s3 = seconds();
+      kruskalMST(dense, tree, &t3);
+      double s4 = seconds();
+      assert(t1 == t2 && t2 == t3 && t3 == t4);
+
+      printf("%8d %10lld %12.4f s %12.4f s %12.4f s %12.4f s\n",
+             density[d], t1, s1 - s0, s2 - s1, s3 - s2, s4 - s3);
+      freeGraph(dense);
+      freeGraph(sparse);
+   }
+   free(tree);
+   return 0;
+}
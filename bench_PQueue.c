@@ -0,0 +1,158 @@
+// Benchmark: Dijkstra over the heap-based pqueue vs. the original array-scan PQueue
+// also checks that the global PQueue still gives the original answers when callers
+// lower priorities of queued vertices without telling it
+// gcc -O2 -pthread -o bench_PQueue bench_PQueue.c PQueue.c WGraph.c Parallel.c
+// (add -DPQ_ARITY=4 to try a 4-ary heap)
+// usage: ./bench_PQueue [average degree] [largest #vertices for the array scan]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include <limits.h>
+#include "PQueue.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// the original PQueue: joins scan item[] for duplicates, leaves scan for the minimum
+static Vertex *scanItem;
+static int     scanLength;
+
+static void scanJoin(Vertex v) {
+   int i = 0;
+   while (i < scanLength && scanItem[i] != v)
+      i++;
+   if (i == scanLength)
+      scanItem[scanLength++] = v;
+}
+
+static Vertex scanLeave(int priority[]) {
+   int i, bestIndex = 0, bestWeight = INT_MAX;
+   for (i = 0; i < scanLength; i++) {
+      if (priority[scanItem[i]] < bestWeight) {
+         bestIndex = i;
+         bestWeight = priority[scanItem[i]];
+      }
+   }
+   Vertex best = scanItem[bestIndex];
+   scanItem[bestIndex] = scanItem[--scanLength];
+   return best;
+}
+
+// textbook Dijkstra: a vertex is (re)joined whenever its distance drops
+#define DIJKSTRA(NAME, INIT, JOIN, LEAVE, EMPTY)                           \
+   static void NAME(Graph g, Vertex src, int dist[]) {                     \
+      int nV = numOfVertices(g), v, w, weight;                             \
+      for (v = 0; v < nV; v++)                                             \
+         dist[v] = INT_MAX;                                                \
+      dist[src] = 0;                                                       \
+      INIT;                                                                \
+      JOIN(src);                                                           \
+      while (!(EMPTY)) {                                                   \
+         v = LEAVE(dist);                                                  \
+         NeighbourIter it;                                                 \
+         for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); ) {  \
+            if (dist[v] + weight < dist[w]) {                              \
+               dist[w] = dist[v] + weight;                                 \
+               JOIN(w);                                                    \
+            }                                                              \
+         }                                                                 \
+      }                                                                    \
+   }
+
+static pqueue heap;
+#define HEAP_JOIN(v)  pqJoin(heap, v)
+#define HEAP_LEAVE(d) pqLeave(heap, d)
+
+DIJKSTRA(scanDijkstra, scanLength = 0, scanJoin, scanLeave, scanLength == 0)
+DIJKSTRA(heapDijkstra, pqClear(heap), HEAP_JOIN, HEAP_LEAVE, pqIsEmpty(heap))
+
+// the classic COMP9024 pattern: join every vertex up front, then only lower dist[]
+static void joinAllDijkstra(Graph g, Vertex src, int dist[]) {
+   int nV = numOfVertices(g), v, w, weight;
+   PQueueInit();
+   for (v = 0; v < nV; v++) {
+      dist[v] = INT_MAX;
+      joinPQueue(v);
+   }
+   dist[src] = 0;
+   while (!PQueueIsEmpty()) {
+      v = leavePQueue(dist);
+      if (dist[v] == INT_MAX)
+         continue;
+      NeighbourIter it;
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); )
+         if (dist[v] + weight < dist[w])
+            dist[w] = dist[v] + weight;
+   }
+}
+
+// 0->1 (10), 0->2 (1), 2->1 (1), 1->3 (1): dist[1] drops while 1 is queued
+static void checkJoinAll(void) {
+   Edge e[] = { { 0, 1, 10 }, { 0, 2, 1 }, { 2, 1, 1 }, { 1, 3, 1 } };
+   int dist[4], v;
+   static const int expect[4] = { 0, 2, 1, 3 };
+   Graph g = newGraphFromEdges(4, e, 4);
+   joinAllDijkstra(g, 0, dist);
+   for (v = 0; v < 4; v++)
+      assert(dist[v] == expect[v]);
+   freeGraph(g);
+}
+
+int main(int argc, char *argv[]) {
+   int avg     = (argc > 1) ? atoi(argv[1]) : 8;
+   int maxScan = (argc > 2) ? atoi(argv[2]) : 100000;
+   int nV, i, v;
+
+   checkJoinAll();
+   heap = newPQueue();
+   printf("average degree %d, %d-ary heap\n", avg, PQ_ARITY);
+   printf("%10s %14s %14s\n", "vertices", "array scan", "heap");
+   for (nV = 1000; nV <= 1000000; nV *= 10) {
+      int nE = nV * avg;
+      Edge *edges = malloc(nE * sizeof(Edge));
+      assert(edges != NULL);
+      srand(9024);
+      for (i = 0; i < nE; i++) {
+         edges[i].v = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+         edges[i].w = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+         edges[i].weight = 1 + rand() % 100;
+      }
+      Graph g = newSparseGraphFromEdges(nV, edges, nE);
+      free(edges);
+
+      int *d1 = malloc(nV * sizeof(int));
+      int *d2 = malloc(nV * sizeof(int));
+      scanItem = malloc(nV * sizeof(Vertex));
+      assert(d1 != NULL && d2 != NULL && scanItem != NULL);
+
+      double t0 = seconds();
+      heapDijkstra(g, 0, d1);
+      double t1 = seconds();
+      printf("%10d ", nV);
+      if (nV <= maxScan) {
+         scanDijkstra(g, 0, d2);
+         double t2 = seconds();
+         for (v = 0; v < nV; v++)
+            assert(d1[v] == d2[v]);
+         joinAllDijkstra(g, 0, d2);
+         for (v = 0; v < nV; v++)
+            assert(d1[v] == d2[v]);
+         printf("%12.4f s ", t2 - t1);
+      } else {
+         printf("%14s ", "-");
+      }
+      printf("%12.4f s\n", t1 - t0);
+
+      free(d1);
+      free(d2);
+      free(scanItem);
+      freeGraph(g);
+   }
+   dropPQueue(heap);
+   return 0;
+}
@@ -0,0 +1,80 @@
+// Benchmark: List and RBTree nodes from malloc vs. a Pool, teardown by walking vs. poolReset
+// gcc -O2 -pthread -o bench_Pool bench_Pool.c Pool.c List.c RBTree.c
+// usage: ./bench_Pool [#tree items] [#lists] [list length]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "List.h"
+#include "RBTree.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// returns the time to build the structures; *teardown = time to free them
+static double trees(int n, pool p, double *teardown) {
+   int i;
+   useTreePool(p);
+   double t0 = seconds();
+   Tree t = newTree();
+   for (i = 0; i < n; i++)
+      t = TreeInsert(t, (int)(((unsigned)i * 2654435761u) % (unsigned)n));
+   double t1 = seconds();
+   assert(TreeSearch(t, n / 2));
+   if (p != NULL)
+      poolReset(p);
+   else
+      freeTree(t);
+   *teardown = seconds() - t1;
+   return t1 - t0;
+}
+
+static double lists(int nLists, int len, pool p, double *teardown) {
+   int i, j;
+   List *L = calloc(nLists, sizeof(List));
+   assert(L != NULL);
+   useListPool(p);
+   double t0 = seconds();
+   for (j = 0; j < len; j++)          // interleaved, as adjacency lists are built
+      for (i = 0; i < nLists; i++)
+         L[i] = insertLL(L[i], len - j);
+   double t1 = seconds();
+   if (p != NULL) {
+      poolReset(p);
+   } else {
+      for (i = 0; i < nLists; i++)
+         freeLL(L[i]);
+   }
+   *teardown = seconds() - t1;
+   free(L);
+   return t1 - t0;
+}
+
+int main(int argc, char *argv[]) {
+   int n      = (argc > 1) ? atoi(argv[1]) : 2000000;
+   int nLists = (argc > 2) ? atoi(argv[2]) : 200000;
+   int len    = (argc > 3) ? atoi(argv[3]) : 8;
+   double b1, d1, b2, d2;
+
+   pool treePool = newPool(sizeof(Node));
+   printf("%-26s %10s %10s\n", "", "build", "teardown");
+   b1 = trees(n, NULL, &d1);
+   b2 = trees(n, treePool, &d2);
+   printf("RBTree, %d items\n", n);
+   printf("%-26s %8.3f s %8.4f s\n", "  malloc + freeTree", b1, d1);
+   printf("%-26s %8.3f s %8.4f s\n", "  Pool + poolReset", b2, d2);
+   dropPool(treePool);
+
+   pool listPool = newPool(2 * sizeof(void *));   // List nodes are private to List.c
+   b1 = lists(nLists, len, NULL, &d1);
+   b2 = lists(nLists, len, listPool, &d2);
+   printf("%d lists of %d items\n", nLists, len);
+   printf("%-26s %8.3f s %8.4f s\n", "  malloc + freeLL", b1, d1);
+   printf("%-26s %8.3f s %8.4f s\n", "  Pool + poolReset", b2, d2);
+   dropPool(listPool);
+   return 0;
+}
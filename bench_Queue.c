@@ -0,0 +1,119 @@
+// Benchmark: ring-buffer Queue vs. the original linked-list Queue
+// gcc -O2 -o bench_Queue bench_Queue.c Queue.c
+// usage: ./bench_Queue [#items]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include "Queue.h"
+
+#define BATCH 64
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// the original Queue: one malloc'd node per item
+typedef struct node {
+   int data;
+   struct node *next;
+} NodeT;
+
+static NodeT *head = NULL, *tail = NULL;
+
+static void linkedEnqueue(int v) {
+   NodeT *new = malloc(sizeof(NodeT));
+   assert(new != NULL);
+   new->data = v;
+   new->next = NULL;
+   if (tail != NULL)
+      tail->next = new;
+   else
+      head = new;
+   tail = new;
+}
+
+static int linkedDequeue(void) {
+   NodeT *p = head;
+   head = head->next;
+   if (head == NULL)
+      tail = NULL;
+   int d = p->data;
+   free(p);
+   return d;
+}
+
+// BFS-like traffic: the queue grows to n/2 items, then drains while refilling
+int main(int argc, char *argv[]) {
+   int n = (argc > 1) ? atoi(argv[1]) : 10000000;
+   int i, j;
+   long long sum[4] = { 0 };
+   int buf[BATCH];
+
+   double t0 = seconds();
+   for (i = 0; i < n / 2; i++)
+      linkedEnqueue(i);
+   for (i = n / 2; i < n; i++) {
+      sum[0] += linkedDequeue();
+      linkedEnqueue(i);
+   }
+   while (head != NULL)
+      sum[0] += linkedDequeue();
+
+   double t1 = seconds();
+   queue Q = newQueue();
+   for (i = 0; i < n / 2; i++)
+      QueueEnqueue(Q, i);
+   for (i = n / 2; i < n; i++) {
+      sum[1] += QueueDequeue(Q);
+      QueueEnqueue(Q, i);
+   }
+   while (!QueueIsEmpty(Q))
+      sum[1] += QueueDequeue(Q);
+   dropQueue(Q);
+
+   double t2 = seconds();
+   Q = newQueueReserve(n / 2);
+   for (i = 0; i < n / 2; i++)
+      QueueEnqueue(Q, i);
+   for (i = n / 2; i < n; i++) {
+      sum[2] += QueueDequeue(Q);
+      QueueEnqueue(Q, i);
+   }
+   while (!QueueIsEmpty(Q))
+      sum[2] += QueueDequeue(Q);
+   dropQueue(Q);
+
+   double t3 = seconds();
+   Q = newQueueReserve(n / 2);
+   for (i = 0; i < n / 2; i += BATCH) {
+      int k = (n / 2 - i < BATCH) ? n / 2 - i : BATCH;
+      for (j = 0; j < k; j++)
+         buf[j] = i + j;
+      QueueEnqueueN(Q, buf, k);
+   }
+   for (i = n / 2; i < n; i += BATCH) {
+      int k = QueueDequeueN(Q, buf, (n - i < BATCH) ? n - i : BATCH);
+      for (j = 0; j < k; j++) {
+         sum[3] += buf[j];
+         buf[j] = i + j;
+      }
+      QueueEnqueueN(Q, buf, k);
+   }
+   while ((j = QueueDequeueN(Q, buf, BATCH)) > 0)
+      while (j > 0)
+         sum[3] += buf[--j];
+   dropQueue(Q);
+   double t4 = seconds();
+
+   assert(sum[0] == sum[1] && sum[1] == sum[2] && sum[2] == sum[3]);
+   printf("%d items through the queue\n", n);
+   printf("linked list:            %8.3f s\n", t1 - t0);
+   printf("ring buffer:            %8.3f s (%.1fx)\n", t2 - t1, (t1 - t0) / (t2 - t1));
+   printf("ring buffer, reserved:  %8.3f s (%.1fx)\n", t3 - t2, (t1 - t0) / (t3 - t2));
+   printf("batches of %d:          %8.3f s (%.1fx)\n", BATCH, t4 - t3, (t1 - t0) / (t4 - t3));
+   return 0;
+}
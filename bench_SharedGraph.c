@@ -0,0 +1,122 @@
+// Stress test and benchmark: readers of a SharedGraph while one writer publishes batches
+// gcc -O2 -pthread -o bench_SharedGraph bench_SharedGraph.c SharedGraph.c WGraph.c Parallel.c
+// (add -fsanitize=address or -fsanitize=thread to check version reclamation)
+// usage: ./bench_SharedGraph [#vertices] [#readers] [#batches]
+//
+// the graph starts as batch 1 and batch b replaces every edge by
+// i -> (i + shift(b)) % V with weight b, so a reader that sees a version halfway
+// through a batch, or a freed one, finds an edge that does not fit vertex 0's
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include <pthread.h>
+#include "SharedGraph.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static int nV;
+
+static int shift(int b) {
+   return 1 + b % (nV - 1);
+}
+
+typedef struct {
+   SharedGraph s;
+   int         reader;
+   bool       *stop;
+   long long   reads;
+} ReaderArgs;
+
+// every vertex has exactly one edge, and all of them belong to the same batch
+static int checkVersion(Graph g) {
+   int b = 0, v;
+   for (v = 0; v < nV; v++) {
+      NeighbourIter it;
+      Vertex w;
+      int weight, n = 0;
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); n++) {
+         if (v == 0)
+            b = weight;
+         assert(weight == b && w == (v + shift(b)) % nV);
+      }
+      assert(n == 1);
+   }
+   return b;
+}
+
+static void *reader(void *p) {
+   ReaderArgs *a = p;
+   int last = 0;
+   while (!__atomic_load_n(a->stop, __ATOMIC_ACQUIRE)) {
+      Graph g = readBegin(a->s, a->reader);
+      int b = checkVersion(g);
+      readEnd(a->s, a->reader);
+      assert(b >= last);   // versions never go back
+      last = b;
+      a->reads++;
+   }
+   return NULL;
+}
+
+int main(int argc, char *argv[]) {
+   nV = (argc > 1) ? atoi(argv[1]) : 1000;
+   int nR = (argc > 2) ? atoi(argv[2]) : 4;
+   int nB = (argc > 3) ? atoi(argv[3]) : 2000;
+   assert(nV >= 2 && nR >= 1 && nB >= 1);
+   int b, v, r;
+
+   Graph g = newSparseGraph(nV);
+   for (v = 0; v < nV; v++) {   // batch 1
+      Edge e = { v, (v + shift(1)) % nV, 1 };
+      insertEdge(g, e);
+   }
+   SharedGraph s = newSharedGraph(g, nR);
+
+   bool stop = false;
+   pthread_t  *thread = malloc(nR * sizeof(pthread_t));
+   ReaderArgs *args = malloc(nR * sizeof(ReaderArgs));
+   assert(thread != NULL && args != NULL);
+   for (r = 0; r < nR; r++) {
+      args[r].s = s;
+      args[r].reader = r;
+      args[r].stop = &stop;
+      args[r].reads = 0;
+      assert(pthread_create(&thread[r], NULL, reader, &args[r]) == 0);
+   }
+
+   double t0 = seconds();
+   for (b = 2; b <= nB; b++) {
+      for (v = 0; v < nV; v++) {
+         Edge old = { v, (v + shift(b - 1)) % nV, b - 1 }, e = { v, (v + shift(b)) % nV, b };
+         sharedRemoveEdge(s, old);
+         sharedInsertEdge(s, e);
+      }
+      publish(s);
+   }
+   double t1 = seconds();
+   __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+
+   long long reads = 0;
+   for (r = 0; r < nR; r++) {
+      pthread_join(thread[r], NULL);
+      reads += args[r].reads;
+   }
+   Graph last = readBegin(s, 0);
+   assert(checkVersion(last) == nB);
+   readEnd(s, 0);
+
+   printf("%d vertices, %d readers, %d batches of %d updates\n", nV, nR, nB, 2 * nV);
+   printf("writer:  %8.3f s, %10.0f publishes/s\n", t1 - t0, (nB - 1) / (t1 - t0));
+   printf("readers: %lld whole versions checked, %10.0f/s\n", reads, reads / (t1 - t0));
+
+   free(thread);
+   free(args);
+   freeSharedGraph(s);
+   return 0;
+}
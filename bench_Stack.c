@@ -0,0 +1,136 @@
+// Benchmark: iterative DFS over the array-backed Stack vs. the original linked-list Stack
+// gcc -O2 -pthread -o bench_Stack bench_Stack.c Stack.c WGraph.c Parallel.c
+// usage: ./bench_Stack [#vertices] [average degree]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "Stack.h"
+#include "WGraph.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// the original Stack: one malloc'd node per item
+typedef struct node {
+   int data;
+   struct node *next;
+} NodeT;
+
+static NodeT *top = NULL;
+
+static void linkedPush(int v) {
+   NodeT *new = malloc(sizeof(NodeT));
+   assert(new != NULL);
+   new->data = v;
+   new->next = top;
+   top = new;
+}
+
+static int linkedPop(void) {
+   NodeT *p = top;
+   top = top->next;
+   int d = p->data;
+   free(p);
+   return d;
+}
+
+// iterative DFS from 0: a vertex is pushed once per incoming edge and visited
+// when first popped; returns a checksum of the visiting order
+#define DFS(NAME, INIT, PUSH, POP, EMPTY, DONE)                            \
+   static long long NAME(Graph g, bool visited[]) {                        \
+      int nV = numOfVertices(g), w, weight, order = 0;                     \
+      long long sum = 0;                                                   \
+      memset(visited, 0, nV * sizeof(bool));                               \
+      INIT;                                                                \
+      PUSH(0);                                                             \
+      while (!(EMPTY)) {                                                   \
+         Vertex v = POP();                                                 \
+         if (visited[v])                                                   \
+            continue;                                                      \
+         visited[v] = true;                                                \
+         sum += (long long)v * ++order;                                    \
+         NeighbourIter it;                                                 \
+         for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); )    \
+            if (!visited[w])                                               \
+               PUSH(w);                                                    \
+      }                                                                    \
+      DONE;                                                                \
+      return sum;                                                          \
+   }
+
+static stack S;
+#define ARRAY_PUSH(v) StackPush(S, v)
+#define ARRAY_POP()   StackPop(S)
+
+DFS(linkedDFS, (void)0, linkedPush, linkedPop, top == NULL, (void)0)
+DFS(arrayDFS, S = newStack(), ARRAY_PUSH, ARRAY_POP, StackIsEmpty(S), dropStack(S))
+
+// same visiting order, but each vertex's unvisited neighbours go on in one StackPushN
+static long long batchDFS(Graph g, bool visited[], int buf[]) {
+   int nV = numOfVertices(g), w, weight, order = 0;
+   long long sum = 0;
+   memset(visited, 0, nV * sizeof(bool));
+   S = newStackReserve(nV);
+   StackPush(S, 0);
+   while (!StackIsEmpty(S)) {
+      Vertex v = StackPop(S);
+      if (visited[v])
+         continue;
+      visited[v] = true;
+      sum += (long long)v * ++order;
+      int n = 0;
+      NeighbourIter it;
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); )
+         if (!visited[w])
+            buf[n++] = w;
+      StackPushN(S, buf, n);
+   }
+   dropStack(S);
+   return sum;
+}
+
+int main(int argc, char *argv[]) {
+   int nV  = (argc > 1) ? atoi(argv[1]) : 4000000;
+   int avg = (argc > 2) ? atoi(argv[2]) : 4;
+   int nE = nV * avg, i;
+
+   Edge *edges = malloc(nE * sizeof(Edge));
+   assert(edges != NULL);
+   srand(9024);
+   for (i = 0; i < nE; i++) {
+      edges[i].v = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      edges[i].w = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      edges[i].weight = 1;
+   }
+   Graph g = newSparseGraphFromEdges(nV, edges, nE);
+   free(edges);
+
+   bool *visited = malloc(nV * sizeof(bool));
+   int  *buf = malloc(nV * sizeof(int));   // a vertex's out-degree is below nV
+   assert(visited != NULL && buf != NULL);
+
+   double t0 = seconds();
+   long long s1 = linkedDFS(g, visited);
+   double t1 = seconds();
+   long long s2 = arrayDFS(g, visited);
+   double t2 = seconds();
+   long long s3 = batchDFS(g, visited, buf);
+   double t3 = seconds();
+   assert(s1 == s2 && s2 == s3);
+
+   printf("%d vertices, %d edges\n", nV, nE);
+   printf("linked list:         %8.3f s\n", t1 - t0);
+   printf("array:               %8.3f s\n", t2 - t1);
+   printf("array + StackPushN:  %8.3f s\n", t3 - t2);
+
+   free(visited);
+   free(buf);
+   freeGraph(g);
+   return 0;
+}
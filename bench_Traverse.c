@@ -0,0 +1,80 @@
+// Benchmark: reachability by sequential Stack DFS vs. parallelTraverse on 1, 2, 4, ... workers
+// gcc -O2 -pthread -o bench_Traverse bench_Traverse.c Traverse.c WSDeque.c Stack.c Graph.c Parallel.c
+// usage: ./bench_Traverse [#vertices] [average degree] [largest #threads]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "Traverse.h"
+#include "Parallel.h"
+#include "Stack.h"
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static int stackReach(Graph g, Vertex src, bool visited[]) {
+   int n = 0;
+   Vertex w;
+   stack S = newStackReserve(numOfVertices(g));
+   visited[src] = true;
+   StackPush(S, src);
+   while (!StackIsEmpty(S)) {
+      Vertex v = StackPop(S);
+      n++;
+      NeighbourIter it;
+      for (neighbours(g, v, &it); nextNeighbour(&it, &w); )
+         if (!visited[w]) {
+            visited[w] = true;
+            StackPush(S, w);
+         }
+   }
+   dropStack(S);
+   return n;
+}
+
+int main(int argc, char *argv[]) {
+   int nV   = (argc > 1) ? atoi(argv[1]) : 4000000;
+   int avg  = (argc > 2) ? atoi(argv[2]) : 8;
+   int maxT = (argc > 3) ? atoi(argv[3]) : numWorkers();
+   int nE = (int)((long long)nV * avg / 2), i, T;
+
+   Edge *edges = malloc(nE * sizeof(Edge));
+   assert(edges != NULL);
+   srand(9024);
+   for (i = 0; i < nE; i++) {
+      edges[i].v = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+      edges[i].w = (int)((((unsigned)rand() << 15) ^ (unsigned)rand()) % nV);
+   }
+   Graph g = newSparseGraphFromEdges(nV, edges, nE);
+   free(edges);
+
+   bool *visited = calloc(nV, sizeof(bool));
+   assert(visited != NULL);
+   double t0 = seconds();
+   int reached = stackReach(g, 0, visited);
+   double t1 = seconds();
+   double base = t1 - t0;
+   printf("%d vertices, average degree %d, %d reachable from 0\n", nV, avg, reached);
+   printf("%8s %10s %10s\n", "threads", "seconds", "speedup");
+   printf("%8s %10.3f %10s\n", "Stack", base, "1.00");
+
+   for (T = 1; T <= maxT; T = (T < maxT && 2 * T > maxT) ? maxT : 2 * T) {   // 1, 2, 4, ..., maxT
+      setNumWorkers(T);
+      Vertex src = 0;
+      memset(visited, 0, nV * sizeof(bool));
+      t0 = seconds();
+      int n = parallelTraverse(g, &src, 1, visited, NULL, NULL);
+      t1 = seconds();
+      assert(n == reached);
+      printf("%8d %10.3f %10.2f\n", T, t1 - t0, base / (t1 - t0));
+   }
+
+   free(visited);
+   freeGraph(g);
+   return 0;
+}
@@ -0,0 +1,128 @@
+// Benchmark: O(V^2) dense Dijkstra on WGraph vs. the weight-specialised matrices of WGraphT
+// gcc -O3 -march=native -pthread -o bench_WGraphT bench_WGraphT.c WGraphT.c WGraph.c Parallel.c
+// usage: ./bench_WGraphT [#vertices] [edge density in %]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include <limits.h>
+#include <float.h>
+#include "WGraph.h"
+#include "WGraphT.h"
+
+#define REPEAT 5
+
+static double seconds(void) {
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Dijkstra with a linear scan for the minimum, relaxing one row per step
+// distances are of type D with INF for "not reached"
+#define DENSE_DIJKSTRA(NAME, G, D, INF, RELAX)                     \
+   static void NAME(G g, int nV, D dist[], bool done[]) {          \
+      int v, w, weight;                                            \
+      for (v = 0; v < nV; v++) {                                   \
+         dist[v] = INF;                                            \
+         done[v] = false;                                          \
+      }                                                            \
+      dist[0] = 0;                                                 \
+      for (;;) {                                                   \
+         int best = -1;                                            \
+         for (v = 0; v < nV; v++)                                  \
+            if (!done[v] && (best < 0 || dist[v] < dist[best]))    \
+               best = v;                                           \
+         if (best < 0 || dist[best] == INF)                        \
+            break;                                                 \
+         v = best;                                                 \
+         done[v] = true;                                           \
+         RELAX;                                                    \
+      }                                                            \
+      (void)w;                                                     \
+      (void)weight;                                                \
+   }
+
+// INF is far enough below the type's maximum that INF + weight cannot overflow
+DENSE_DIJKSTRA(dijkstraWGraph, Graph, int, INT_MAX / 2, {
+   NeighbourIter it;
+   for (neighbours(g, v, &it); nextNeighbour(&it, &w, &weight); )
+      if (dist[v] + weight < dist[w])
+         dist[w] = dist[v] + weight;
+})
+DENSE_DIJKSTRA(dijkstraI32, WGraphI32, int64_t, INT64_MAX / 2, relaxRowI32(g, v, dist[v], dist))
+DENSE_DIJKSTRA(dijkstraU16, WGraphU16, int, INT_MAX / 2, relaxRowU16(g, v, dist[v], dist))
+DENSE_DIJKSTRA(dijkstraU8,  WGraphU8,  int, INT_MAX / 2, relaxRowU8(g, v, dist[v], dist))
+DENSE_DIJKSTRA(dijkstraF32, WGraphF32, float, FLT_MAX / 2, relaxRowF32(g, v, dist[v], dist))
+
+int main(int argc, char *argv[]) {
+   int nV      = (argc > 1) ? atoi(argv[1]) : 4000;
+   int density = (argc > 2) ? atoi(argv[2]) : 20;
+   int i, v, w;
+
+   Graph g = newGraph(nV);
+   srand(9024);
+   for (v = 0; v < nV; v++)
+      for (w = 0; w < nV; w++)
+         if (v != w && rand() % 100 < density)
+            insertEdge(g, (Edge){ v, w, 1 + rand() % 255 });
+
+   WGraphU8  g8  = convertWGraphU8(g);
+   WGraphU16 g16 = convertWGraphU16(g);
+   WGraphI32 g32 = convertWGraphI32(g);
+   WGraphF32 gf  = convertWGraphF32(g);
+
+   int     *ref  = malloc(nV * sizeof(int));
+   int     *dist = malloc(nV * sizeof(int));
+   int64_t *dist64 = malloc(nV * sizeof(int64_t));
+   float   *distF = malloc(nV * sizeof(float));
+   bool    *done = malloc(nV * sizeof(bool));
+   assert(ref != NULL && dist != NULL && dist64 != NULL && distF != NULL && done != NULL);
+
+   double t0 = seconds();
+   for (i = 0; i < REPEAT; i++)
+      dijkstraWGraph(g, nV, ref, done);
+   double t1 = seconds();
+   for (i = 0; i < REPEAT; i++)
+      dijkstraI32(g32, nV, dist64, done);
+   double t2 = seconds();
+   for (v = 0; v < nV; v++)
+      assert(dist64[v] == (ref[v] == INT_MAX / 2 ? INT64_MAX / 2 : ref[v]));
+   for (i = 0; i < REPEAT; i++)
+      dijkstraU16(g16, nV, dist, done);
+   double t3 = seconds();
+   for (v = 0; v < nV; v++)
+      assert(dist[v] == ref[v]);
+   for (i = 0; i < REPEAT; i++)
+      dijkstraU8(g8, nV, dist, done);
+   double t4 = seconds();
+   for (v = 0; v < nV; v++)
+      assert(dist[v] == ref[v]);
+   for (i = 0; i < REPEAT; i++)
+      dijkstraF32(gf, nV, distF, done);
+   double t5 = seconds();
+   // path costs stay below 2^24, so float sums are exact
+   for (v = 0; v < nV; v++)
+      assert(distF[v] == (ref[v] == INT_MAX / 2 ? FLT_MAX / 2 : (float)ref[v]));
+
+   double mb = (double)nV * nV / (1 << 20);
+   printf("%d vertices, %d edges\n", nV, wgNumOfEdges(g32));
+   printf("WGraph (int):  %7.1f MB  %8.3f s\n", mb * sizeof(int), (t1 - t0) / REPEAT);
+   printf("WGraphI32:     %7.1f MB  %8.3f s\n", mb * 4, (t2 - t1) / REPEAT);
+   printf("WGraphU16:     %7.1f MB  %8.3f s\n", mb * 2, (t3 - t2) / REPEAT);
+   printf("WGraphU8:      %7.1f MB  %8.3f s\n", mb * 1, (t4 - t3) / REPEAT);
+   printf("WGraphF32:     %7.1f MB  %8.3f s\n", mb * 4, (t5 - t4) / REPEAT);
+
+   free(ref);
+   free(dist);
+   free(done);
+   free(dist64);
+   free(distF);
+   wgFree(g8);
+   wgFree(g16);
+   wgFree(g32);
+   wgFree(gf);
+   freeGraph(g);
+   return 0;
+}
@@ -16,6 +16,21 @@
  * 总体时间复杂度: O(n + m + f + q*(n² + m + f))
  * 但由于查询处理过程中不需要重复处理所有步行连接和渡轮连接，
  * 可以简化为: O(n + m + f + q*n²)
+ *
+ * 时刻表预处理 O(f log f):
+ * - 删除被支配的渡轮班次（同一航线上另有班次出发不早于且到达不晚于它）
+ * - 将等间隔、等时长的班次压缩为 (首班, 间隔, 班次数) 服务记录，
+ *   查询时每条服务O(1)求出可乘坐的班次；设压缩后服务数为s，
+ *   每次查询时间复杂度为O(n² + n*(m + s))
+ *
+ * 到达时间模式 (./tripPlan -a):
+ * - 反向Dijkstra：每次选最晚出发时间最大的地标，
+ *   沿反向渡轮服务和反向步行连接松弛，一次搜索求出最晚出发时间
+ *
+ * 桶队列 (./tripPlan -b，需用 gcc -DBUCKET_QUEUE tripPlan.c BucketQueue.c 编译):
+ * - 时间都是一天内的分钟数且按非递减顺序取出，每次选点改用Dial桶队列，
+ *   不再线性扫描所有地标；选点总代价为O(n + 1440)
+ * - 不加 -b 时两种编译都使用线性扫描，输出完全相同
  */
 
 #include <stdio.h>
@@ -24,11 +39,28 @@
 #include <limits.h>
 #include <stdbool.h>
 
+#ifdef BUCKET_QUEUE
+#include "BucketQueue.h"
+// queue为NULL时使用线性扫描
+#define FRONTIER_PUSH(q, v, key) do { if ((q) != NULL) BucketQueuePush(q, v, key); } while (0)
+#else
+#define FRONTIER_PUSH(q, v, key) ((void)0)   // 线性扫描不需要队列
+#endif
+
 #define MAX_LANDMARKS 100
 #define MAX_NAME_LEN 32
 #define MINUTES_PER_DAY 1440
+#define NO_DEPARTURE -1   // nextDeparture/lastDeparture: 没有可乘坐的班次
 #define NO_ROUTE "No route.\n"
 
+#define USAGE \
+    "usage: ./tripPlan [-a] [-b]\n" \
+    "  -a  queries give the latest arrival time instead of the departure time\n" \
+    "  -b  pick landmarks with a bucket queue instead of a linear scan\n" \
+    "      (build with: gcc -DBUCKET_QUEUE tripPlan.c BucketQueue.c)\n"
+
+bool useBuckets = false;   // -b
+
 // 表示四位数时间 (hhmm)
 typedef int Time;
 
@@ -69,6 +101,17 @@ typedef struct {
     int travelTime;         // 旅行时间（分钟）
 } FerrySchedule;
 
+// 渡轮服务：同一航线上等间隔、等时长的若干班次
+// 第k班 (0 <= k < count) 的出发时间为 firstDeparture + k*headway
+typedef struct {
+    int from;               // 出发地标索引
+    int to;                 // 到达地标索引
+    int firstDeparture;     // 首班出发时间（分钟）
+    int headway;            // 发车间隔（分钟），只有一班时为0
+    int count;              // 班次数
+    int travelTime;         // 旅行时间（分钟）
+} FerryService;
+
 // 路径节点类型
 enum RouteType {
     WALK,
@@ -93,18 +136,42 @@ WalkingLink *walkingLinks = NULL;         // 步行连接数组
 int numWalkingLinks = 0;                  // 步行连接数量
 FerrySchedule *ferrySchedules = NULL;     // 渡轮时刻表数组
 int numFerrySchedules = 0;                // 渡轮时刻表数量
+FerryService *ferryServices = NULL;       // 压缩后的渡轮服务数组
+int numFerryServices = 0;                 // 渡轮服务数量
 
 // 函数声明
 int findLandmarkIndex(const char *name);
 void readLandmarks();
 void readWalkingLinks();
 void readFerrySchedules();
+void preprocessTimetable();
 RouteNode* findRoute(int fromLandmark, int toLandmark, int departureMinutes);
+RouteNode* findLatestRoute(int fromLandmark, int toLandmark, int arrivalMinutes);
 void printRoute(RouteNode *route);
 void freeRoute(RouteNode *route);
 
 // 主函数
-int main() {
+// 使用 -a 参数时，查询输入的是最晚到达时间，输出最晚出发的路线
+// 使用 -b 参数时，Dijkstra用桶队列选点（见USAGE）
+int main(int argc, char *argv[]) {
+    bool arriveBy = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0) {
+            arriveBy = true;
+        } else if (strcmp(argv[i], "-b") == 0) {
+            useBuckets = true;
+        } else {
+            fprintf(stderr, USAGE);
+            return 1;
+        }
+    }
+#ifndef BUCKET_QUEUE
+    if (useBuckets) {
+        fprintf(stderr, "tripPlan: built without -DBUCKET_QUEUE, using the linear scan\n" USAGE);
+        useBuckets = false;
+    }
+#endif
+    
     // 读取地标
     printf("Number of landmarks: ");
     scanf("%d", &numLandmarks);
@@ -158,12 +225,14 @@ int main() {
         ferrySchedules[i].travelTime = ferrySchedules[i].arrivalMinutes - ferrySchedules[i].departureMinutes;
     }
     
+    preprocessTimetable();
+    
     // 处理用户查询
     while (1) {
         char fromName[MAX_NAME_LEN];
         
         printf("\nFrom: ");
-        scanf("%s", fromName);
+        if (scanf("%s", fromName) != 1) break;   // 输入结束
         
         // 检查是否结束
         if (strcmp(fromName, "done") == 0) {
@@ -172,20 +241,31 @@ int main() {
         }
         
         char toName[MAX_NAME_LEN];
-        int departureTime;
+        int queryTime;
         
         printf("To: ");
-        scanf("%s", toName);
+        if (scanf("%s", toName) != 1) break;
         
-        printf("Departure time: ");
-        scanf("%d", &departureTime);
+        printf(arriveBy ? "Arrival time: " : "Departure time: ");
+        if (scanf("%d", &queryTime) != 1) break;
         
         int fromIndex = findLandmarkIndex(fromName);
         int toIndex = findLandmarkIndex(toName);
-        int departureMinutes = timeToMinutes(departureTime);
+        int queryMinutes = timeToMinutes(queryTime);
+        
+        // 未知地标
+        if (fromIndex < 0 || toIndex < 0) {
+            printf("\n" NO_ROUTE);
+            continue;
+        }
         
         // 寻找路线
-        RouteNode *route = findRoute(fromIndex, toIndex, departureMinutes);
+        RouteNode *route;
+        if (arriveBy) {
+            route = findLatestRoute(fromIndex, toIndex, queryMinutes);
+        } else {
+            route = findRoute(fromIndex, toIndex, queryMinutes);
+        }
         
         // 打印路线
         printf("\n");
@@ -199,7 +279,7 @@ int main() {
     
     // 释放内存
     free(walkingLinks);
-    free(ferrySchedules);
+    free(ferryServices);
     
     return 0;
 }
@@ -239,6 +319,139 @@ RouteNode* addRouteNode(RouteNode *head, enum RouteType type, int from, int to,
     return head;
 }
 
+// 比较函数：按航线、出发时间升序排列，同一出发时间按到达时间降序
+int compareSchedules(const void *a, const void *b) {
+    const FerrySchedule *fa = a;
+    const FerrySchedule *fb = b;
+    if (fa->from != fb->from) return fa->from - fb->from;
+    if (fa->to != fb->to) return fa->to - fb->to;
+    if (fa->departureMinutes != fb->departureMinutes)
+        return fa->departureMinutes - fb->departureMinutes;
+    return fb->arrivalMinutes - fa->arrivalMinutes;
+}
+
+// 比较函数：按航线、旅行时间、出发时间升序排列
+int compareByService(const void *a, const void *b) {
+    const FerrySchedule *fa = a;
+    const FerrySchedule *fb = b;
+    if (fa->from != fb->from) return fa->from - fb->from;
+    if (fa->to != fb->to) return fa->to - fb->to;
+    if (fa->travelTime != fb->travelTime) return fa->travelTime - fb->travelTime;
+    return fa->departureMinutes - fb->departureMinutes;
+}
+
+// 时刻表预处理：删除被支配的班次，并把等间隔班次压缩为服务记录
+// 处理完成后释放原始渡轮时刻表，查询只使用ferryServices
+void preprocessTimetable() {
+    qsort(ferrySchedules, numFerrySchedules, sizeof(FerrySchedule), compareSchedules);
+    
+    // 1. 删除被支配的班次
+    // 同一航线内从最晚出发的班次向前扫描，只保留到达时间严格更早的班次
+    bool *keep = malloc(numFerrySchedules * sizeof(bool));
+    int numKept = 0;
+    int minArrival = INT_MAX;
+    for (int i = numFerrySchedules - 1; i >= 0; i--) {
+        if (i == numFerrySchedules - 1 ||
+            ferrySchedules[i].from != ferrySchedules[i + 1].from ||
+            ferrySchedules[i].to != ferrySchedules[i + 1].to) {
+            minArrival = INT_MAX;   // 新的航线
+        }
+        keep[i] = ferrySchedules[i].arrivalMinutes < minArrival;
+        if (keep[i]) {
+            minArrival = ferrySchedules[i].arrivalMinutes;
+            numKept++;
+        }
+    }
+    
+    int n = 0;
+    for (int i = 0; i < numFerrySchedules; i++) {
+        if (keep[i]) {
+            ferrySchedules[n++] = ferrySchedules[i];
+        }
+    }
+    free(keep);
+    
+    // 2. 压缩：同一航线上时长相同、间隔相同的连续班次合并为一条服务
+    qsort(ferrySchedules, n, sizeof(FerrySchedule), compareByService);
+    ferryServices = malloc((n > 0 ? n : 1) * sizeof(FerryService));
+    numFerryServices = 0;
+    int i = 0;
+    while (i < n) {
+        FerrySchedule *first = &ferrySchedules[i];
+        int headway = 0;
+        int count = 1;
+        
+        if (i + 1 < n && ferrySchedules[i + 1].from == first->from &&
+            ferrySchedules[i + 1].to == first->to &&
+            ferrySchedules[i + 1].travelTime == first->travelTime) {
+            headway = ferrySchedules[i + 1].departureMinutes - first->departureMinutes;
+            count = 2;
+            while (i + count < n &&
+                   ferrySchedules[i + count].from == first->from &&
+                   ferrySchedules[i + count].to == first->to &&
+                   ferrySchedules[i + count].travelTime == first->travelTime &&
+                   ferrySchedules[i + count].departureMinutes -
+                   ferrySchedules[i + count - 1].departureMinutes == headway) {
+                count++;
+            }
+        }
+        
+        FerryService *s = &ferryServices[numFerryServices++];
+        s->from = first->from;
+        s->to = first->to;
+        s->firstDeparture = first->departureMinutes;
+        s->headway = headway;
+        s->count = count;
+        s->travelTime = first->travelTime;
+        i += count;
+    }
+    
+    // 报告压缩效果（写到stderr，不影响查询输出）
+    fprintf(stderr, "Timetable: %d ferry schedules, %d dominated removed, "
+            "%d services (%zu -> %zu bytes)\n",
+            numFerrySchedules, numFerrySchedules - n, numFerryServices,
+            numFerrySchedules * sizeof(FerrySchedule),
+            numFerryServices * sizeof(FerryService));
+    
+    free(ferrySchedules);
+    ferrySchedules = NULL;
+    numFerrySchedules = 0;
+}
+
+// 返回服务s中不早于time出发的第一班的出发时间，没有则返回NO_DEPARTURE
+int nextDeparture(const FerryService *s, int time) {
+    int k = 0;
+    if (time > s->firstDeparture) {
+        if (s->headway == 0) return NO_DEPARTURE;
+        k = (time - s->firstDeparture + s->headway - 1) / s->headway;
+    }
+    return (k < s->count) ? s->firstDeparture + k * s->headway : NO_DEPARTURE;
+}
+
+// 返回服务s中不晚于time到达的最后一班的出发时间，没有则返回NO_DEPARTURE
+// （调用者必须先检查：NO_DEPARTURE仍大于latest[]的初值INT_MIN）
+int lastDeparture(const FerryService *s, int time) {
+    int latest = time - s->travelTime - s->firstDeparture;
+    if (latest < 0) return NO_DEPARTURE;
+    int k = (s->headway == 0) ? 0 : latest / s->headway;
+    if (k >= s->count) k = s->count - 1;
+    return s->firstDeparture + k * s->headway;
+}
+
+#ifdef BUCKET_QUEUE
+// 一次松弛中键值的最大增量：等船不超过一天，再加上最长的步行或航行时间
+int maxStepMinutes() {
+    int longest = 0;
+    for (int i = 0; i < numWalkingLinks; i++) {
+        if (walkingLinks[i].walkingTime > longest) longest = walkingLinks[i].walkingTime;
+    }
+    for (int i = 0; i < numFerryServices; i++) {
+        if (ferryServices[i].travelTime > longest) longest = ferryServices[i].travelTime;
+    }
+    return MINUTES_PER_DAY + longest;
+}
+#endif
+
 // 寻找路线（使用Dijkstra算法）
 RouteNode* findRoute(int fromLandmark, int toLandmark, int departureMinutes) {
     // 初始化距离数组和前驱节点数组
@@ -261,17 +474,28 @@ RouteNode* findRoute(int fromLandmark, int toLandmark, int departureMinutes) {
     
     // 设置起点
     dist[fromLandmark] = departureMinutes;
+#ifdef BUCKET_QUEUE
+    BucketQueue queue = useBuckets ? newBucketQueue(numLandmarks, maxStepMinutes()) : NULL;
+    FRONTIER_PUSH(queue, fromLandmark, departureMinutes);
+#endif
     
     // Dijkstra算法
     for (int count = 0; count < numLandmarks; count++) {
         // 找到距离最小的未访问节点
-        int minDist = INT_MAX;
         int u = -1;
         
-        for (int i = 0; i < numLandmarks; i++) {
-            if (!visited[i] && dist[i] < minDist) {
-                minDist = dist[i];
-                u = i;
+#ifdef BUCKET_QUEUE
+        if (queue != NULL) {
+            if (!BucketQueueIsEmpty(queue)) u = BucketQueuePop(queue, NULL);
+        } else
+#endif
+        {
+            int minDist = INT_MAX;
+            for (int i = 0; i < numLandmarks; i++) {
+                if (!visited[i] && dist[i] < minDist) {
+                    minDist = dist[i];
+                    u = i;
+                }
             }
         }
         
@@ -293,6 +517,7 @@ RouteNode* findRoute(int fromLandmark, int toLandmark, int departureMinutes) {
                     prev[v] = u;
                     prevType[v] = WALK;
                     prevDepartureTime[v] = dist[u];
+                    FRONTIER_PUSH(queue, v, newDist);
                 }
             } else if (walkingLinks[i].to == u) {
                 // 步行连接是双向的
@@ -304,29 +529,36 @@ RouteNode* findRoute(int fromLandmark, int toLandmark, int departureMinutes) {
                     prev[v] = u;
                     prevType[v] = WALK;
                     prevDepartureTime[v] = dist[u];
+                    FRONTIER_PUSH(queue, v, newDist);
                 }
             }
         }
         
         // 2. 通过渡轮
-        for (int i = 0; i < numFerrySchedules; i++) {
-            if (ferrySchedules[i].from == u && 
-                ferrySchedules[i].departureMinutes >= dist[u]) { // 确保渡轮出发时间晚于到达时间
-                
-                int v = ferrySchedules[i].to;
-                int newDist = ferrySchedules[i].arrivalMinutes;
-                
-                if (!visited[v] && newDist < dist[v]) {
-                    dist[v] = newDist;
-                    prev[v] = u;
-                    prevType[v] = FERRY;
-                    prevDepartureTime[v] = ferrySchedules[i].departureMinutes;
-                    ferry[v] = i;  // 记录使用的渡轮
-                }
+        for (int i = 0; i < numFerryServices; i++) {
+            if (ferryServices[i].from != u) continue;
+            
+            int departure = nextDeparture(&ferryServices[i], dist[u]); // 确保渡轮出发时间晚于到达时间
+            if (departure == NO_DEPARTURE) continue;
+            
+            int v = ferryServices[i].to;
+            int newDist = departure + ferryServices[i].travelTime;
+            
+            if (!visited[v] && newDist < dist[v]) {
+                dist[v] = newDist;
+                prev[v] = u;
+                prevType[v] = FERRY;
+                prevDepartureTime[v] = departure;
+                ferry[v] = i;  // 记录使用的渡轮服务
+                FRONTIER_PUSH(queue, v, newDist);
             }
         }
     }
     
+#ifdef BUCKET_QUEUE
+    if (queue != NULL) dropBucketQueue(queue);
+#endif
+    
     // 如果没有路径到达目标地标
     if (dist[toLandmark] == INT_MAX) {
         return NULL;
@@ -348,9 +580,8 @@ RouteNode* findRoute(int fromLandmark, int toLandmark, int departureMinutes) {
             // 添加渡轮路径节点
             int ferryIndex = ferry[current];
             route = addRouteNode(route, FERRY, previous, current, 
-                                ferrySchedules[ferryIndex].departureMinutes,
-                                ferrySchedules[ferryIndex].arrivalMinutes,
-                                ferrySchedules[ferryIndex].travelTime);
+                                prevDepartureTime[current], dist[current],
+                                ferryServices[ferryIndex].travelTime);
         }
         
         current = previous;
@@ -370,6 +601,125 @@ RouteNode* findRoute(int fromLandmark, int toLandmark, int departureMinutes) {
     return reversedRoute;
 }
 
+// 寻找最晚出发路线（反向Dijkstra）
+// latest[x]表示从x出发仍能在arrivalMinutes之前到达目标的最晚时间
+RouteNode* findLatestRoute(int fromLandmark, int toLandmark, int arrivalMinutes) {
+    int latest[MAX_LANDMARKS];
+    int next[MAX_LANDMARKS];                 // 路线中的下一个地标
+    enum RouteType nextType[MAX_LANDMARKS];  // 下一步是步行还是渡轮
+    int nextDuration[MAX_LANDMARKS];         // 下一步所需时间
+    bool visited[MAX_LANDMARKS];
+    
+    // 初始化
+    for (int i = 0; i < numLandmarks; i++) {
+        latest[i] = INT_MIN;
+        next[i] = -1;
+        nextType[i] = WALK;
+        nextDuration[i] = 0;
+        visited[i] = false;
+    }
+    
+    // 设置终点
+    latest[toLandmark] = arrivalMinutes;
+#ifdef BUCKET_QUEUE
+    // 键值为 arrivalMinutes - latest，最晚出发时间越大越先取出
+    BucketQueue queue = useBuckets ? newBucketQueue(numLandmarks, maxStepMinutes()) : NULL;
+    FRONTIER_PUSH(queue, toLandmark, 0);
+#endif
+    
+    for (int count = 0; count < numLandmarks; count++) {
+        // 找到最晚出发时间最大的未访问节点
+        int u = -1;
+        
+#ifdef BUCKET_QUEUE
+        if (queue != NULL) {
+            if (!BucketQueueIsEmpty(queue)) u = BucketQueuePop(queue, NULL);
+        } else
+#endif
+        {
+            int maxLatest = INT_MIN;
+            for (int i = 0; i < numLandmarks; i++) {
+                if (!visited[i] && latest[i] > maxLatest) {
+                    maxLatest = latest[i];
+                    u = i;
+                }
+            }
+        }
+        
+        // 如果没有可访问的节点，或者起点的最晚出发时间已确定，则退出
+        if (u == -1 || u == fromLandmark) break;
+        
+        visited[u] = true;
+        
+        // 1. 反向步行（步行连接是双向的）
+        for (int i = 0; i < numWalkingLinks; i++) {
+            int x;
+            if (walkingLinks[i].to == u) {
+                x = walkingLinks[i].from;
+            } else if (walkingLinks[i].from == u) {
+                x = walkingLinks[i].to;
+            } else {
+                continue;
+            }
+            
+            int leave = latest[u] - walkingLinks[i].walkingTime;
+            if (!visited[x] && leave >= 0 && leave > latest[x]) {
+                latest[x] = leave;
+                next[x] = u;
+                nextType[x] = WALK;
+                nextDuration[x] = walkingLinks[i].walkingTime;
+                FRONTIER_PUSH(queue, x, arrivalMinutes - leave);
+            }
+        }
+        
+        // 2. 反向渡轮：到达u不晚于latest[u]的最后一班
+        for (int i = 0; i < numFerryServices; i++) {
+            if (ferryServices[i].to != u) continue;
+            
+            int x = ferryServices[i].from;
+            int departure = lastDeparture(&ferryServices[i], latest[u]);
+            if (departure == NO_DEPARTURE) continue;   // 没有赶得上的班次
+            
+            if (!visited[x] && departure > latest[x]) {
+                latest[x] = departure;
+                next[x] = u;
+                nextType[x] = FERRY;
+                nextDuration[x] = ferryServices[i].travelTime;
+                FRONTIER_PUSH(queue, x, arrivalMinutes - departure);
+            }
+        }
+    }
+#ifdef BUCKET_QUEUE
+    if (queue != NULL) dropBucketQueue(queue);
+#endif
+    
+    // 如果无法按时到达目标地标
+    if (latest[fromLandmark] == INT_MIN) {
+        return NULL;
+    }
+    
+    // 从起点正向构建路径
+    RouteNode *route = NULL;
+    int current = fromLandmark;
+    int time = latest[fromLandmark];
+    
+    while (current != toLandmark) {
+        if (nextType[current] == WALK) {
+            route = addRouteNode(route, WALK, current, next[current],
+                                time, time + nextDuration[current], nextDuration[current]);
+        } else {
+            time = latest[current];   // 乘坐最晚一班仍能赶上的渡轮
+            route = addRouteNode(route, FERRY, current, next[current],
+                                time, time + nextDuration[current], nextDuration[current]);
+        }
+        
+        time += nextDuration[current];
+        current = next[current];
+    }
+    
+    return route;
+}
+
 // 打印路径
 void printRoute(RouteNode *route) {
     RouteNode *current = route;